@@ -0,0 +1,323 @@
+/**
+ * Benchmarks of ekuvector against std::vector: appending, reserving, inserting,
+ * erasing, assigning, copying, moving, iterating and comparing trivial, string
+ * and heavy move-only elements.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// google benchmark
+#include "benchmark/benchmark.h"
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* Element types. The trivial one is moved around with plain byte copies,
+ * std::string owns heap memory once it's past the small string buffer, and
+ * the heavy one is a wide move-only object. */
+using Trivial = int64_t;
+
+class Heavy {
+public:
+  explicit Heavy(int64_t value) : handle_{std::make_unique<int64_t>(value)} {
+    payload_.fill(value);
+  }
+  Heavy(Heavy &&) = default;
+  Heavy &operator=(Heavy &&) = default;
+
+  int64_t value() const { return payload_[0]; }
+
+private:
+  std::array<int64_t, 16> payload_;
+  std::unique_ptr<int64_t> handle_;
+};
+
+template <class Type> Type make_value(int64_t index);
+
+template <> Trivial make_value<Trivial>(int64_t index) { return index; }
+
+template <> std::string make_value<std::string>(int64_t index) {
+  // long enough to defeat the small string optimization
+  return std::string(24, static_cast<char>('a' + index % 26));
+}
+
+template <> Heavy make_value<Heavy>(int64_t index) { return Heavy{index}; }
+
+int64_t key_of(const Trivial &value) { return value; }
+int64_t key_of(const std::string &value) {
+  return static_cast<int64_t>(value.size());
+}
+int64_t key_of(const Heavy &value) { return value.value(); }
+
+template <class Container> Container make_container(int64_t count) {
+  Container container;
+  container.reserve(static_cast<std::size_t>(count));
+  for (int64_t index = 0; index < count; ++index) {
+    container.push_back(make_value<typename Container::value_type>(index));
+  }
+  return container;
+}
+
+/* 16 elements up to 100M, in steps of 8x */
+void container_sizes(benchmark::internal::Benchmark *bench) {
+  for (int64_t count = 16; count < 100000000; count *= 8) {
+    bench->Arg(count);
+  }
+  bench->Arg(100000000);
+}
+
+template <class Container> void BM_PushBack(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  const auto count = state.range(0);
+  for (auto _ : state) {
+    Container container;
+    for (int64_t index = 0; index < count; ++index) {
+      container.push_back(make_value<value_type>(index));
+    }
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class Container> void BM_EmplaceBack(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  const auto count = state.range(0);
+  for (auto _ : state) {
+    Container container;
+    for (int64_t index = 0; index < count; ++index) {
+      container.emplace_back(make_value<value_type>(index));
+    }
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class Container> void BM_ReservedPushBack(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  const auto count = state.range(0);
+  for (auto _ : state) {
+    Container container;
+    container.reserve(static_cast<std::size_t>(count));
+    for (int64_t index = 0; index < count; ++index) {
+      container.push_back(make_value<value_type>(index));
+    }
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+/* Cost of relocating count elements to a new, larger block */
+template <class Container> void BM_Reserve(benchmark::State &state) {
+  const auto count = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto container = make_container<Container>(count);
+    state.ResumeTiming();
+    container.reserve(container.capacity() * 2);
+    benchmark::DoNotOptimize(container.data());
+    /* the elements are destroyed outside of the measure too */
+    state.PauseTiming();
+    Container().swap(container);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+/* Each iteration inserts one element and then pops one at the back, so that
+ * the size stays the same and the measure is dominated by the insertion */
+template <class Container> void BM_InsertFront(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  auto container = make_container<Container>(state.range(0));
+  for (auto _ : state) {
+    container.insert(container.begin(), make_value<value_type>(0));
+    container.pop_back();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container> void BM_InsertMiddle(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  auto container = make_container<Container>(state.range(0));
+  for (auto _ : state) {
+    container.insert(container.begin() + container.size() / 2,
+                     make_value<value_type>(0));
+    container.pop_back();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/* Each iteration erases one element and then appends another one at the
+ * back, so that the size stays the same */
+template <class Container> void BM_EraseFront(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  auto container = make_container<Container>(state.range(0));
+  for (auto _ : state) {
+    container.erase(container.begin());
+    container.push_back(make_value<value_type>(0));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container> void BM_EraseMiddle(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  auto container = make_container<Container>(state.range(0));
+  for (auto _ : state) {
+    container.erase(container.begin() + container.size() / 2);
+    container.push_back(make_value<value_type>(0));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container> void BM_AssignCount(benchmark::State &state) {
+  using value_type = typename Container::value_type;
+  const auto count = state.range(0);
+  const auto value = make_value<value_type>(42);
+  Container container;
+  for (auto _ : state) {
+    container.assign(static_cast<std::size_t>(count), value);
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class Container> void BM_AssignRange(benchmark::State &state) {
+  const auto count = state.range(0);
+  const auto source = make_container<Container>(count);
+  Container container;
+  for (auto _ : state) {
+    container.assign(source.begin(), source.end());
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class Container> void BM_CopyConstruct(benchmark::State &state) {
+  const auto count = state.range(0);
+  const auto source = make_container<Container>(count);
+  for (auto _ : state) {
+    Container container(source);
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class Container> void BM_CopyAssign(benchmark::State &state) {
+  const auto count = state.range(0);
+  const auto source = make_container<Container>(count);
+  Container container;
+  for (auto _ : state) {
+    container = source;
+    benchmark::DoNotOptimize(container.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+/* The moved contents are swapped back after each move, so both containers
+ * are ready for the next iteration */
+template <class Container> void BM_MoveConstruct(benchmark::State &state) {
+  auto source = make_container<Container>(state.range(0));
+  for (auto _ : state) {
+    Container container(std::move(source));
+    benchmark::DoNotOptimize(container.data());
+    source.swap(container);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container> void BM_MoveAssign(benchmark::State &state) {
+  auto source = make_container<Container>(state.range(0));
+  Container container;
+  for (auto _ : state) {
+    container = std::move(source);
+    benchmark::DoNotOptimize(container.data());
+    source.swap(container);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container> void BM_Iterate(benchmark::State &state) {
+  const auto count = state.range(0);
+  const auto container = make_container<Container>(count);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const auto &item : container) {
+      sum += key_of(item);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+/* The containers only differ in their last element, so the whole contents get
+ * scanned */
+template <class Container> void BM_Equal(benchmark::State &state) {
+  const auto count = state.range(0);
+  const auto lhs = make_container<Container>(count);
+  auto rhs = make_container<Container>(count);
+  rhs.back() = make_value<typename Container::value_type>(count + 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class Container> void BM_Less(benchmark::State &state) {
+  const auto count = state.range(0);
+  const auto lhs = make_container<Container>(count);
+  auto rhs = make_container<Container>(count);
+  rhs.back() = make_value<typename Container::value_type>(count + 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs < rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+/* Registers a benchmark for std::vector and ekuvector of a given type, so they
+ * show up side by side in the report */
+#define EKU_BENCHMARK_TYPE(bench, value_type)                                  \
+  BENCHMARK_TEMPLATE(bench, std::vector<value_type>)->Apply(container_sizes);  \
+  BENCHMARK_TEMPLATE(bench, ekuvector<value_type>)->Apply(container_sizes)
+
+/* Operations that every element type supports */
+#define EKU_BENCHMARK_ALL_TYPES(bench)                                         \
+  EKU_BENCHMARK_TYPE(bench, Trivial);                                          \
+  EKU_BENCHMARK_TYPE(bench, std::string);                                      \
+  EKU_BENCHMARK_TYPE(bench, Heavy)
+
+/* Operations that need to copy elements, so move-only types are left out */
+#define EKU_BENCHMARK_COPYABLE_TYPES(bench)                                    \
+  EKU_BENCHMARK_TYPE(bench, Trivial);                                          \
+  EKU_BENCHMARK_TYPE(bench, std::string)
+
+EKU_BENCHMARK_ALL_TYPES(BM_PushBack);
+EKU_BENCHMARK_ALL_TYPES(BM_EmplaceBack);
+EKU_BENCHMARK_ALL_TYPES(BM_ReservedPushBack);
+EKU_BENCHMARK_ALL_TYPES(BM_Reserve);
+EKU_BENCHMARK_ALL_TYPES(BM_InsertFront);
+EKU_BENCHMARK_ALL_TYPES(BM_InsertMiddle);
+EKU_BENCHMARK_ALL_TYPES(BM_EraseFront);
+EKU_BENCHMARK_ALL_TYPES(BM_EraseMiddle);
+EKU_BENCHMARK_COPYABLE_TYPES(BM_AssignCount);
+EKU_BENCHMARK_COPYABLE_TYPES(BM_AssignRange);
+EKU_BENCHMARK_COPYABLE_TYPES(BM_CopyConstruct);
+EKU_BENCHMARK_COPYABLE_TYPES(BM_CopyAssign);
+EKU_BENCHMARK_ALL_TYPES(BM_MoveConstruct);
+EKU_BENCHMARK_ALL_TYPES(BM_MoveAssign);
+EKU_BENCHMARK_ALL_TYPES(BM_Iterate);
+EKU_BENCHMARK_COPYABLE_TYPES(BM_Equal);
+EKU_BENCHMARK_COPYABLE_TYPES(BM_Less);
+
+}; // namespace ekustd
@@ -0,0 +1,106 @@
+/**
+ * ekualigned_allocator, over-aligned storage for SIMD-friendly containers.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief Allocator whose blocks start at an Align bytes boundary.
+ *
+ * Align must be a power of two, and not less than the alignment of Type. Each
+ * block is carved from a slightly larger one obtained from the global operator
+ * new, with the address of the latter stashed right before the aligned block.
+ * The allocator is stateless, and all of its instances compare equal. */
+template <class Type, std::size_t Align = 64> class ekualigned_allocator {
+  static_assert(Align > 0 && (Align & (Align - 1)) == 0,
+                "the alignment must be a power of two");
+  static_assert(Align >= alignof(Type),
+                "the alignment can't be less than the one of the type");
+
+public:
+  using value_type = Type;
+  using pointer = Type *;
+  using const_pointer = const Type *;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using is_always_equal = std::true_type;
+
+  /** @brief Alignment of every block, in bytes. */
+  static constexpr std::size_t alignment = Align;
+
+  template <class Other> struct rebind {
+    using other = ekualigned_allocator<Other, Align>;
+  };
+
+  ekualigned_allocator() noexcept = default;
+
+  template <class Other>
+  ekualigned_allocator(const ekualigned_allocator<Other, Align> &) noexcept {}
+
+  Type *allocate(std::size_t n) {
+    if (n > max_size()) {
+      throw std::bad_array_new_length();
+    }
+    auto raw = static_cast<char *>(::operator new(n * sizeof(Type) + padding));
+    const auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void *));
+    const auto aligned = (address + Align - 1) & ~(Align - 1);
+    auto block = raw + (aligned - reinterpret_cast<std::uintptr_t>(raw));
+    reinterpret_cast<void **>(block)[-1] = raw;
+    return reinterpret_cast<Type *>(block);
+  }
+
+  void deallocate(Type *p, std::size_t /* n */) noexcept {
+    ::operator delete(reinterpret_cast<void **>(p)[-1]);
+  }
+
+  std::size_t max_size() const noexcept {
+    return (SIZE_MAX - padding) / sizeof(Type);
+  }
+
+private:
+  /* room for the stashed address, plus the worst case misalignment */
+  static constexpr std::size_t padding = sizeof(void *) + Align - 1;
+};
+
+template <class Type, std::size_t Align>
+constexpr std::size_t ekualigned_allocator<Type, Align>::alignment;
+
+template <class Type, std::size_t Align>
+constexpr std::size_t ekualigned_allocator<Type, Align>::padding;
+
+template <class Type, class Other, std::size_t Align>
+bool operator==(const ekualigned_allocator<Type, Align> &,
+                const ekualigned_allocator<Other, Align> &) noexcept {
+  return true;
+}
+
+template <class Type, class Other, std::size_t Align>
+bool operator!=(const ekualigned_allocator<Type, Align> &,
+                const ekualigned_allocator<Other, Align> &) noexcept {
+  return false;
+}
+
+/** @brief ekuvector whose data() is aligned to Align bytes, and whose capacity
+ *         always fills a whole number of Align bytes vector lanes, so that
+ *         kernels can process the final lane without peeling the tail. */
+template <class Type, std::size_t Align = 64,
+          class BaseGrowth = geometric_growth<>>
+using ekualigned_vector =
+    ekuvector<Type, ekualigned_allocator<Type, Align>,
+              vector_width_growth<Align, BaseGrowth>>;
+
+}; // namespace ekustd
@@ -0,0 +1,192 @@
+/**
+ * ekuarena_allocator, bump-pointer allocator for request-scoped containers.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace ekustd {
+
+/** @brief Monotonic memory arena.
+ *
+ * Allocations are carved sequentially from a buffer optionally supplied by the
+ * user, and then from chunks obtained from the global operator new, each twice
+ * as large as the previous one. Individual deallocations are no-ops, except for
+ * the most recent allocation, which gets rolled back so that a growing
+ * container can reuse the top of the arena. Everything is returned at once by
+ * release() or by the destructor. */
+class ekuarena {
+public:
+  /** @brief Constructs an empty arena, that takes memory from the heap in
+   *         chunks starting at chunk_size bytes. */
+  explicit ekuarena(std::size_t chunk_size = 4096) noexcept
+      : ekuarena(nullptr, 0, chunk_size) {}
+
+  /** @brief Constructs an arena that serves allocations from buffer until it
+   *         runs out of room, and only then goes to the heap. The buffer is not
+   *         owned by the arena, and must outlive it. */
+  ekuarena(void *buffer, std::size_t size,
+           std::size_t chunk_size = 4096) noexcept
+      : initial_buffer_{static_cast<char *>(buffer)}, initial_size_{size},
+        initial_chunk_size_{std::max<std::size_t>(chunk_size, 64)},
+        cursor_{initial_buffer_}, end_{initial_buffer_ + size},
+        chunks_{nullptr}, chunk_count_{0},
+        next_chunk_size_{initial_chunk_size_} {}
+
+  ekuarena(const ekuarena &) = delete;
+  ekuarena &operator=(const ekuarena &) = delete;
+
+  /** @brief Destructor. Releases the memory taken from the heap. */
+  ~ekuarena() { release(); }
+
+  /** @brief Returns bytes of storage aligned to alignment, which must be a
+   *         power of two. */
+  void *allocate(std::size_t bytes, std::size_t alignment) {
+    auto block = align_up(cursor_, alignment);
+    if (!block || (block > end_) ||
+        (bytes > static_cast<std::size_t>(end_ - block))) {
+      add_chunk(bytes + alignment);
+      block = align_up(cursor_, alignment);
+    }
+    cursor_ = block + bytes;
+    return block;
+  }
+
+  /** @brief Rolls back the allocation of block if it was the last one, and
+   *         does nothing otherwise. */
+  void deallocate(void *block, std::size_t bytes) noexcept {
+    if (static_cast<char *>(block) + bytes == cursor_) {
+      cursor_ = static_cast<char *>(block);
+    }
+  }
+
+  /** @brief Returns all the memory taken from the heap, and restarts
+   *         allocating from the user supplied buffer, if any. Every block
+   *         handed out by the arena is invalidated. */
+  void release() noexcept {
+    while (chunks_) {
+      auto next = chunks_->next;
+      ::operator delete(static_cast<void *>(chunks_));
+      chunks_ = next;
+    }
+    chunk_count_ = 0;
+    cursor_ = initial_buffer_;
+    end_ = initial_buffer_ + initial_size_;
+    next_chunk_size_ = initial_chunk_size_;
+  }
+
+  /** @brief Returns the number of chunks currently taken from the heap. */
+  std::size_t chunk_count() const noexcept { return chunk_count_; }
+
+private:
+  struct chunk_header {
+    chunk_header *next;
+  };
+
+  /* chunk payloads start at a fundamental alignment boundary */
+  static constexpr std::size_t header_size =
+      ((sizeof(chunk_header) + alignof(std::max_align_t) - 1) /
+       alignof(std::max_align_t)) *
+      alignof(std::max_align_t);
+
+  char *initial_buffer_;
+  std::size_t initial_size_;
+  std::size_t initial_chunk_size_;
+  char *cursor_;
+  char *end_;
+  chunk_header *chunks_;
+  std::size_t chunk_count_;
+  std::size_t next_chunk_size_;
+
+  static char *align_up(char *ptr, std::size_t alignment) noexcept {
+    if (!ptr) {
+      return nullptr;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+    return ptr + (aligned - address);
+  }
+
+  void add_chunk(std::size_t min_payload) {
+    const auto payload = std::max(next_chunk_size_, min_payload);
+    auto raw = static_cast<char *>(::operator new(header_size + payload));
+    auto header = reinterpret_cast<chunk_header *>(raw);
+    header->next = chunks_;
+    chunks_ = header;
+    ++chunk_count_;
+    cursor_ = raw + header_size;
+    end_ = cursor_ + payload;
+    next_chunk_size_ = payload * 2;
+  }
+};
+
+/** @brief Allocator that takes its memory from an ekuarena.
+ *
+ * Copies refer to the same arena, and two allocators compare equal if they do.
+ * The allocator does not propagate on container copy, move or swap, so each
+ * container stays bound to the arena it was created with. Moving between
+ * containers on the same arena hands the storage over in O(1). Moves across
+ * arenas fall back to element-wise moves. */
+template <class Type> class ekuarena_allocator {
+public:
+  using value_type = Type;
+  using pointer = Type *;
+  using const_pointer = const Type *;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+  template <class Other> struct rebind {
+    using other = ekuarena_allocator<Other>;
+  };
+
+  /** @brief Constructs an allocator that takes memory from arena. */
+  ekuarena_allocator(ekuarena &arena) noexcept : arena_{&arena} {}
+
+  template <class Other>
+  ekuarena_allocator(const ekuarena_allocator<Other> &other) noexcept
+      : arena_{other.arena_} {}
+
+  Type *allocate(std::size_t n) {
+    return static_cast<Type *>(
+        arena_->allocate(n * sizeof(Type), alignof(Type)));
+  }
+
+  void deallocate(Type *p, std::size_t n) noexcept {
+    arena_->deallocate(static_cast<void *>(p), n * sizeof(Type));
+  }
+
+  /** @brief Returns the arena this allocator takes memory from. */
+  ekuarena &arena() const noexcept { return *arena_; }
+
+private:
+  template <class Other> friend class ekuarena_allocator;
+
+  ekuarena *arena_;
+};
+
+template <class Type, class Other>
+bool operator==(const ekuarena_allocator<Type> &lhs,
+                const ekuarena_allocator<Other> &rhs) noexcept {
+  return &lhs.arena() == &rhs.arena();
+}
+
+template <class Type, class Other>
+bool operator!=(const ekuarena_allocator<Type> &lhs,
+                const ekuarena_allocator<Other> &rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}; // namespace ekustd
@@ -0,0 +1,1006 @@
+/**
+ * ekuchunked_vector, vector made of fixed-size chunks with stable addresses.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief Vector whose elements are stored in chunks of ChunkSize elements,
+ *         which never move once allocated.
+ *
+ * Growing appends a new chunk to a table of chunks, an ekuvector of pointers,
+ * so the elements are never relocated and references to them stay valid until
+ * they are erased, as those of std::deque. ChunkSize is a power of two, which
+ * keeps indexed access down to a shift, a mask and two loads.
+ *
+ * The member interface is the one of ekuvector, minus data(): bulk consumers
+ * can process the contents chunk by chunk with for_each_segment(). Iterators
+ * are random access, and refer to positions rather than to elements, so they
+ * remain valid across growth. */
+template <class Type, std::size_t ChunkSize = 1024,
+          class Allocator = std::allocator<Type>>
+class ekuchunked_vector {
+  static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                "the chunk size must be a power of two");
+  /* the table of chunks stores raw pointers */
+  static_assert(
+      std::is_same<typename std::allocator_traits<Allocator>::pointer,
+                   Type *>::value,
+      "ekuchunked_vector requires an allocator with raw pointers");
+
+  template <bool Const> class basic_iterator;
+
+public:
+  using type = Type;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = Type;
+  using allocator_type = Allocator;
+
+  using pointer = Type *;
+  using const_pointer = const Type *;
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /** @brief Number of elements in a chunk. */
+  static constexpr size_type chunk_size = ChunkSize;
+
+  /** @brief Default constructor. Constructs an empty container, with no
+   *         chunks. */
+  ekuchunked_vector() noexcept(noexcept(Allocator()));
+
+  /** @brief Constructs an empty container with the given allocator alloc. */
+  explicit ekuchunked_vector(const Allocator &alloc) noexcept;
+
+  /** @brief Constructs the container with count default-inserted instances of
+   *         Type. */
+  ekuchunked_vector(size_type count);
+
+  /** @brief Constructs the container with count copies of value. */
+  ekuchunked_vector(size_type count, const Type &value,
+                    const Allocator &alloc = Allocator());
+
+  /** @brief Constructs the container with the contents of the range [first,
+   *         last). */
+  template <class InputIt>
+  ekuchunked_vector(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
+      const Allocator &alloc = Allocator());
+
+  /** @brief Constructs the container with the contents of the initializer list
+   *         init. */
+  ekuchunked_vector(std::initializer_list<Type> init,
+                    const Allocator &alloc = Allocator());
+
+  /** @brief Copy constructor. */
+  ekuchunked_vector(const ekuchunked_vector &other);
+
+  /** @brief Move constructor. Takes over the chunks of other, which is left
+   *         empty. */
+  ekuchunked_vector(ekuchunked_vector &&other) noexcept;
+
+  /** @brief Destructor. */
+  ~ekuchunked_vector();
+
+  /** @brief Copy assignment operator. */
+  ekuchunked_vector &operator=(const ekuchunked_vector &other);
+
+  /** @brief Move assignment operator. The chunks of other are taken over if
+   *         the allocators compare equal, and its elements are moved one by
+   *         one otherwise. */
+  ekuchunked_vector &operator=(ekuchunked_vector &&other);
+
+  /** @brief Replaces the contents with those of the initializer list
+   *         ilist. */
+  ekuchunked_vector &operator=(std::initializer_list<Type> ilist);
+
+  /** @brief Replaces the contents with count copies of value. */
+  void assign(size_type count, const Type &value);
+
+  /** @brief Replaces the contents with copies of those in the range [first,
+   *         last). */
+  template <class InputIt>
+  void assign(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Replaces the contents with the elements of the initializer list
+   *         ilist. */
+  void assign(std::initializer_list<Type> ilist);
+
+  /** @brief Returns the allocator associated with the container. */
+  allocator_type get_allocator() const;
+
+  /** @brief Returns a reference to the element at specified location pos, with
+   *         bounds checking. */
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  /** @brief Returns a reference to the element at specified location pos. No
+   *         bounds checking is performed. */
+  reference operator[](size_type pos) noexcept;
+  const_reference operator[](size_type pos) const noexcept;
+
+  /** @brief Returns a reference to the first element in the container. */
+  reference front() noexcept;
+  const_reference front() const noexcept;
+
+  /** @brief Returns reference to the last element in the container. */
+  reference back() noexcept;
+  const_reference back() const noexcept;
+
+  /** @brief Calls visit(first, count) for each chunk holding elements, with
+   *         a pointer to the count contiguous elements it holds. */
+  template <class Visit> void for_each_segment(Visit visit);
+  template <class Visit> void for_each_segment(Visit visit) const;
+
+  /** @brief Iterators to the beginning of the container. */
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  /** @brief Iterators to the end of the container. */
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  /** @brief Reverse iterators to the beginning of the reversed container. */
+  reverse_iterator rbegin() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator crbegin() const noexcept;
+
+  /** @brief Reverse iterators to the end of the reversed container. */
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rend() const noexcept;
+  const_reverse_iterator crend() const noexcept;
+
+  /** @brief Checks if the container has no elements. */
+  bool empty() const noexcept;
+
+  /** @brief Returns the number of elements in the container. */
+  size_type size() const noexcept;
+
+  /** @brief Returns the maximum number of elements the container is able to
+   *         hold. */
+  size_type max_size() const noexcept;
+
+  /** @brief Allocates chunks until there's room for new_cap elements. */
+  void reserve(size_type new_cap);
+
+  /** @brief Returns the number of elements that the allocated chunks can
+   *         hold. */
+  size_type capacity() const noexcept;
+
+  /** @brief Releases the chunks that hold no elements. */
+  void shrink_to_fit();
+
+  /** @brief Erases all elements from the container, keeping the chunks. */
+  void clear() noexcept;
+
+  /** @brief Inserts value before pos. */
+  iterator insert(const_iterator pos, const Type &value);
+  iterator insert(const_iterator pos, Type &&value);
+
+  /** @brief Inserts count copies of value before pos. */
+  iterator insert(const_iterator pos, size_type count, const Type &value);
+
+  /** @brief Inserts elements from the range [first, last) before pos. */
+  template <class InputIt>
+  iterator insert(
+      const_iterator pos, InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Inserts elements from initializer list ilist before pos. */
+  iterator insert(const_iterator pos, std::initializer_list<Type> ilist);
+
+  /** @brief Inserts a new element constructed from args directly before
+   *         pos. */
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&... args);
+
+  /** @brief Removes the element at pos. */
+  iterator erase(const_iterator pos);
+
+  /** @brief Removes the elements in the range [first, last). */
+  iterator erase(const_iterator first, const_iterator last);
+
+  /** @brief Appends the given element value to the end of the container. No
+   *         element is ever relocated. */
+  void push_back(const Type &value);
+  void push_back(Type &&value);
+
+  /** @brief Appends a new element constructed from args to the end of the
+   *         container. */
+  template <class... Args> reference emplace_back(Args &&... args);
+
+  /** @brief Removes the last element of the container. */
+  void pop_back() noexcept;
+
+  /** @brief Resizes the container to contain count elements, appending
+   *         default-inserted elements if needed. */
+  void resize(size_type count);
+
+  /** @brief Resizes the container to contain count elements, appending copies
+   *         of value if needed. */
+  void resize(size_type count, const value_type &value);
+
+  /** @brief Exchanges the contents of the container with those of other. */
+  void swap(ekuchunked_vector &other) noexcept;
+
+private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using table_type =
+      ekuvector<Type *, typename alloc_traits::template rebind_alloc<Type *>>;
+
+  static constexpr size_type chunk_shift = detail::log2_floor(ChunkSize);
+  static constexpr size_type chunk_mask = ChunkSize - 1;
+
+  Allocator allocator_;
+  table_type chunks_;
+  size_type size_;
+
+  /** @brief Allocates a new chunk at the end of the table. */
+  void add_chunk();
+
+  /** @brief Returns the number of chunks needed to hold count elements. */
+  static size_type chunks_for(size_type count) noexcept;
+
+  /** @brief Destroys the elements past the first count ones. */
+  void truncate(size_type count) noexcept;
+
+  /** @brief Destroys every element and releases all the chunks. */
+  void release() noexcept;
+
+  /** @brief Appends the elements of the range [first, last), removing them
+   *         all again if one of them throws. */
+  template <class InputIt> void append(InputIt first, InputIt last);
+
+  /** @brief Appends count copies of value, removing them all again if one of
+   *         them throws. */
+  void append(size_type count, const Type &value);
+
+  /** @brief Moves the elements appended after the first old_size ones to
+   *         ordinal, and returns an iterator to the first of them. */
+  iterator rotate_appended(size_type ordinal, size_type old_size);
+};
+
+/** @brief Random access iterator over the elements of an ekuchunked_vector. */
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <bool Const>
+class ekuchunked_vector<Type, ChunkSize, Allocator>::basic_iterator {
+  using container_type =
+      typename std::conditional<Const, const ekuchunked_vector,
+                                ekuchunked_vector>::type;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      typename std::conditional<Const, const Type &, Type &>::type;
+  using pointer = typename std::conditional<Const, const Type *, Type *>::type;
+
+  basic_iterator() noexcept : container_{nullptr}, pos_{0} {}
+  basic_iterator(container_type *container, size_type pos) noexcept
+      : container_{container}, pos_{pos} {}
+
+  /* mutable iterators convert to const ones */
+  template <bool OtherConst,
+            class = typename std::enable_if<Const && !OtherConst>::type>
+  basic_iterator(const basic_iterator<OtherConst> &other) noexcept
+      : container_{other.container_}, pos_{other.pos_} {}
+
+  reference operator*() const noexcept { return (*container_)[pos_]; }
+  pointer operator->() const noexcept { return &(*container_)[pos_]; }
+  reference operator[](difference_type offset) const noexcept {
+    return (*container_)[pos_ + offset];
+  }
+
+  basic_iterator &operator++() noexcept {
+    ++pos_;
+    return *this;
+  }
+  basic_iterator operator++(int) noexcept {
+    auto previous = *this;
+    ++pos_;
+    return previous;
+  }
+  basic_iterator &operator--() noexcept {
+    --pos_;
+    return *this;
+  }
+  basic_iterator operator--(int) noexcept {
+    auto previous = *this;
+    --pos_;
+    return previous;
+  }
+  basic_iterator &operator+=(difference_type offset) noexcept {
+    pos_ += offset;
+    return *this;
+  }
+  basic_iterator &operator-=(difference_type offset) noexcept {
+    pos_ -= offset;
+    return *this;
+  }
+  basic_iterator operator+(difference_type offset) const noexcept {
+    return basic_iterator(container_, pos_ + offset);
+  }
+  friend basic_iterator operator+(difference_type offset,
+                                  const basic_iterator &it) noexcept {
+    return it + offset;
+  }
+  basic_iterator operator-(difference_type offset) const noexcept {
+    return basic_iterator(container_, pos_ - offset);
+  }
+  difference_type operator-(const basic_iterator &other) const noexcept {
+    return static_cast<difference_type>(pos_) -
+           static_cast<difference_type>(other.pos_);
+  }
+
+  bool operator==(const basic_iterator &other) const noexcept {
+    return pos_ == other.pos_;
+  }
+  bool operator!=(const basic_iterator &other) const noexcept {
+    return pos_ != other.pos_;
+  }
+  bool operator<(const basic_iterator &other) const noexcept {
+    return pos_ < other.pos_;
+  }
+  bool operator>(const basic_iterator &other) const noexcept {
+    return pos_ > other.pos_;
+  }
+  bool operator<=(const basic_iterator &other) const noexcept {
+    return pos_ <= other.pos_;
+  }
+  bool operator>=(const basic_iterator &other) const noexcept {
+    return pos_ >= other.pos_;
+  }
+
+private:
+  template <bool> friend class basic_iterator;
+  friend class ekuchunked_vector;
+
+  container_type *container_;
+  size_type pos_;
+};
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+constexpr typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+    ekuchunked_vector<Type, ChunkSize, Allocator>::chunk_size;
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+constexpr typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+    ekuchunked_vector<Type, ChunkSize, Allocator>::chunk_shift;
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+constexpr typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+    ekuchunked_vector<Type, ChunkSize, Allocator>::chunk_mask;
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector() noexcept(
+    noexcept(Allocator()))
+    : ekuchunked_vector(Allocator()) {}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    const Allocator &alloc) noexcept
+    : allocator_{alloc}, chunks_(typename table_type::allocator_type(alloc)),
+      size_{0} {}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    size_type count)
+    : ekuchunked_vector() {
+  resize(count);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    size_type count, const Type &value, const Allocator &alloc)
+    : ekuchunked_vector(alloc) {
+  append(count, value);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class InputIt>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
+    const Allocator &alloc)
+    : ekuchunked_vector(alloc) {
+  append(first, last);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    std::initializer_list<Type> init, const Allocator &alloc)
+    : ekuchunked_vector(alloc) {
+  append(init.begin(), init.end());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    const ekuchunked_vector &other)
+    : ekuchunked_vector(
+          alloc_traits::select_on_container_copy_construction(
+              other.allocator_)) {
+  reserve(other.size_);
+  /* whole chunks at a time, so that trivially copyable elements get copied
+     with memcpy() */
+  other.for_each_segment([this](const Type *first, size_type count) {
+    detail::copy_construct_n(allocator_, first, count,
+                             chunks_[size_ >> chunk_shift]);
+    size_ += count;
+  });
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::ekuchunked_vector(
+    ekuchunked_vector &&other) noexcept
+    : allocator_{std::move(other.allocator_)},
+      chunks_{std::move(other.chunks_)}, size_{other.size_} {
+  other.size_ = 0;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator>::~ekuchunked_vector() {
+  release();
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator> &
+ekuchunked_vector<Type, ChunkSize, Allocator>::operator=(
+    const ekuchunked_vector &other) {
+  if (this != &other) {
+    assign(other.begin(), other.end());
+  }
+  return *this;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator> &
+ekuchunked_vector<Type, ChunkSize, Allocator>::operator=(
+    ekuchunked_vector &&other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (alloc_traits::propagate_on_container_move_assignment::value ||
+      (allocator_ == other.allocator_)) {
+    release();
+    detail::propagate_allocator(
+        allocator_, std::move(other.allocator_),
+        typename alloc_traits::propagate_on_container_move_assignment{});
+    chunks_ = std::move(other.chunks_);
+    size_ = other.size_;
+    other.size_ = 0;
+  } else {
+    assign(std::make_move_iterator(other.begin()),
+           std::make_move_iterator(other.end()));
+  }
+  return *this;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+ekuchunked_vector<Type, ChunkSize, Allocator> &
+ekuchunked_vector<Type, ChunkSize, Allocator>::
+operator=(std::initializer_list<Type> ilist) {
+  assign(ilist);
+  return *this;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::assign(size_type count,
+                                                           const Type &value) {
+  clear();
+  append(count, value);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class InputIt>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::assign(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  clear();
+  append(first, last);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::assign(
+    std::initializer_list<Type> ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::allocator_type
+ekuchunked_vector<Type, ChunkSize, Allocator>::get_allocator() const {
+  return allocator_;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("Out of range access to ekuchunked_vector");
+  }
+  return (*this)[pos];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::at(size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("Out of range access to ekuchunked_vector");
+  }
+  return (*this)[pos];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reference
+    ekuchunked_vector<Type, ChunkSize, Allocator>::
+    operator[](size_type pos) noexcept {
+  return chunks_[pos >> chunk_shift][pos & chunk_mask];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reference
+    ekuchunked_vector<Type, ChunkSize, Allocator>::
+    operator[](size_type pos) const noexcept {
+  return chunks_[pos >> chunk_shift][pos & chunk_mask];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::front() noexcept {
+  return *chunks_[0];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::front() const noexcept {
+  return *chunks_[0];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::back() noexcept {
+  return (*this)[size_ - 1];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::back() const noexcept {
+  return (*this)[size_ - 1];
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class Visit>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::for_each_segment(
+    Visit visit) {
+  for (size_type first = 0; first < size_; first += ChunkSize) {
+    visit(chunks_[first >> chunk_shift], std::min(ChunkSize, size_ - first));
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class Visit>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::for_each_segment(
+    Visit visit) const {
+  for (size_type first = 0; first < size_; first += ChunkSize) {
+    visit(static_cast<const Type *>(chunks_[first >> chunk_shift]),
+          std::min(ChunkSize, size_ - first));
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::begin() noexcept {
+  return iterator(this, 0);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::begin() const noexcept {
+  return const_iterator(this, 0);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::cbegin() const noexcept {
+  return const_iterator(this, 0);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::end() noexcept {
+  return iterator(this, size_);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::end() const noexcept {
+  return const_iterator(this, size_);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::cend() const noexcept {
+  return const_iterator(this, size_);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reverse_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reverse_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reverse_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::crbegin() const noexcept {
+  return const_reverse_iterator(cend());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reverse_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reverse_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::const_reverse_iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::crend() const noexcept {
+  return const_reverse_iterator(cbegin());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+bool ekuchunked_vector<Type, ChunkSize, Allocator>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+ekuchunked_vector<Type, ChunkSize, Allocator>::size() const noexcept {
+  return size_;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+ekuchunked_vector<Type, ChunkSize, Allocator>::max_size() const noexcept {
+  return std::min(chunks_.max_size(), SIZE_MAX / ChunkSize) * ChunkSize;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::reserve(
+    size_type new_cap) {
+  if (new_cap > max_size()) {
+    throw std::length_error("ekuchunked_vector::reserve");
+  }
+  const auto chunks = chunks_for(new_cap);
+  if (chunks > chunks_.size()) {
+    chunks_.reserve(chunks);
+    while (chunks_.size() < chunks) {
+      add_chunk();
+    }
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+ekuchunked_vector<Type, ChunkSize, Allocator>::capacity() const noexcept {
+  return chunks_.size() * ChunkSize;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::shrink_to_fit() {
+  const auto needed = chunks_for(size_);
+  while (chunks_.size() > needed) {
+    alloc_traits::deallocate(allocator_, chunks_.back(), ChunkSize);
+    chunks_.pop_back();
+  }
+  chunks_.shrink_to_fit();
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::clear() noexcept {
+  truncate(0);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::insert(const_iterator pos,
+                                                      const Type &value) {
+  return emplace(pos, value);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::insert(const_iterator pos,
+                                                      Type &&value) {
+  return emplace(pos, std::move(value));
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::insert(const_iterator pos,
+                                                      size_type count,
+                                                      const Type &value) {
+  const auto old_size = size_;
+  append(count, value);
+  return rotate_appended(pos.pos_, old_size);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class InputIt>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::insert(
+    const_iterator pos, InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  const auto old_size = size_;
+  append(first, last);
+  return rotate_appended(pos.pos_, old_size);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::insert(
+    const_iterator pos, std::initializer_list<Type> ilist) {
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class... Args>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::emplace(const_iterator pos,
+                                                       Args &&... args) {
+  const auto old_size = size_;
+  emplace_back(std::forward<Args>(args)...);
+  return rotate_appended(pos.pos_, old_size);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::erase(const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::erase(const_iterator first,
+                                                     const_iterator last) {
+  const auto ordinal = first.pos_;
+  if (first != last) {
+    std::move(begin() + last.pos_, end(), begin() + ordinal);
+    truncate(size_ - (last.pos_ - ordinal));
+  }
+  return begin() + ordinal;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::push_back(
+    const Type &value) {
+  emplace_back(value);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::push_back(Type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class... Args>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::reference
+ekuchunked_vector<Type, ChunkSize, Allocator>::emplace_back(Args &&... args) {
+  if (size_ == capacity()) {
+    /* the existing elements stay where they are, so args remain valid even
+       if they refer to one of them */
+    add_chunk();
+  }
+  auto slot = chunks_[size_ >> chunk_shift] + (size_ & chunk_mask);
+  detail::construct(allocator_, slot, std::forward<Args>(args)...);
+  ++size_;
+  return *slot;
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::pop_back() noexcept {
+  truncate(size_ - 1);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::resize(size_type count) {
+  if (count <= size_) {
+    truncate(count);
+    return;
+  }
+  reserve(count);
+  const auto old_size = size_;
+  try {
+    while (size_ < count) {
+      emplace_back();
+    }
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::resize(
+    size_type count, const value_type &value) {
+  if (count <= size_) {
+    truncate(count);
+    return;
+  }
+  append(count - size_, value);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::swap(
+    ekuchunked_vector &other) noexcept {
+  detail::swap_allocators(allocator_, other.allocator_,
+                          typename alloc_traits::propagate_on_container_swap{});
+  chunks_.swap(other.chunks_);
+  std::swap(size_, other.size_);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::add_chunk() {
+  auto chunk = alloc_traits::allocate(allocator_, ChunkSize);
+  try {
+    chunks_.push_back(chunk);
+  } catch (...) {
+    alloc_traits::deallocate(allocator_, chunk, ChunkSize);
+    throw;
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::size_type
+ekuchunked_vector<Type, ChunkSize, Allocator>::chunks_for(
+    size_type count) noexcept {
+  return (count >> chunk_shift) + ((count & chunk_mask) ? 1 : 0);
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::truncate(
+    size_type count) noexcept {
+  /* chunk by chunk, from the back */
+  while (size_ > count) {
+    const auto chunk_first = (size_ - 1) & ~chunk_mask;
+    const auto first = std::max(chunk_first, count);
+    auto chunk = chunks_[chunk_first >> chunk_shift];
+    detail::destroy_range(allocator_, chunk + (first - chunk_first),
+                          chunk + (size_ - chunk_first));
+    size_ = first;
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::release() noexcept {
+  truncate(0);
+  for (auto chunk : chunks_) {
+    alloc_traits::deallocate(allocator_, chunk, ChunkSize);
+  }
+  chunks_.clear();
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+template <class InputIt>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::append(InputIt first,
+                                                           InputIt last) {
+  const auto old_size = size_;
+  try {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+void ekuchunked_vector<Type, ChunkSize, Allocator>::append(size_type count,
+                                                           const Type &value) {
+  const auto old_size = size_;
+  reserve(size_ + count);
+  try {
+    while (size_ - old_size < count) {
+      emplace_back(value);
+    }
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <class Type, std::size_t ChunkSize, class Allocator>
+typename ekuchunked_vector<Type, ChunkSize, Allocator>::iterator
+ekuchunked_vector<Type, ChunkSize, Allocator>::rotate_appended(
+    size_type ordinal, size_type old_size) {
+  std::rotate(begin() + ordinal, begin() + old_size, end());
+  return begin() + ordinal;
+}
+
+/*
+ * *** NON MEMBERS ***
+ * */
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+bool operator==(const ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+                const ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+bool operator!=(const ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+                const ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+bool operator<(const ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+               const ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+bool operator<=(const ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+                const ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+bool operator>(const ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+               const ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) {
+  return rhs < lhs;
+}
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+bool operator>=(const ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+                const ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) {
+  return !(lhs < rhs);
+}
+
+template <class Type, std::size_t ChunkSize, class Alloc>
+void swap(ekuchunked_vector<Type, ChunkSize, Alloc> &lhs,
+          ekuchunked_vector<Type, ChunkSize, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}; // namespace ekustd
@@ -0,0 +1,450 @@
+/**
+ * ekuconcurrent_vector, append-only vector for many concurrent producers.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief Append-only vector that many threads can push_back() into at once.
+ *
+ * Each push claims the next free slot with an atomic fetch-add on the size,
+ * and constructs the element in it without taking any locks. The elements are
+ * stored in segments that are never moved: the first one has room for
+ * FirstSegment elements, and every other one twice as many as the previous
+ * one. A segment is allocated, once, by the first thread that needs it, so
+ * growing never invalidates the references held by other producers.
+ *
+ * Readers can use operator[] on the slots whose push they know to have
+ * finished, or take the contiguous data() view of any complete segment, that
+ * is, one whose elements have all been constructed.
+ *
+ * If the constructor of an element throws, its slot is left empty for good.
+ * The segment holding it never reports complete, and its neighbours remain
+ * accessible by index.
+ *
+ * The allocator is called concurrently, so it must be thread-safe. Members not
+ * marked as thread-safe must not run concurrently with any other member. */
+template <class Type, class Allocator = std::allocator<Type>,
+          std::size_t FirstSegment = 32>
+class ekuconcurrent_vector {
+  static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0,
+                "the size of the first segment must be a power of two");
+  /* segments are published through atomic raw pointers */
+  static_assert(
+      std::is_same<typename std::allocator_traits<Allocator>::pointer,
+                   Type *>::value,
+      "ekuconcurrent_vector requires an allocator with raw pointers");
+
+public:
+  using type = Type;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = Type;
+  using allocator_type = Allocator;
+
+  using pointer = Type *;
+  using const_pointer = const Type *;
+
+  /** @brief Maximum number of segments in a container. */
+  static constexpr size_type max_segments =
+      detail::log2_floor(SIZE_MAX / FirstSegment);
+
+  /** @brief Default constructor. Constructs an empty container, with no
+   *         segments. */
+  ekuconcurrent_vector();
+
+  /** @brief Constructs an empty container with the given allocator alloc. */
+  explicit ekuconcurrent_vector(const Allocator &alloc);
+
+  ekuconcurrent_vector(const ekuconcurrent_vector &) = delete;
+  ekuconcurrent_vector &operator=(const ekuconcurrent_vector &) = delete;
+
+  /** @brief Destructor. */
+  ~ekuconcurrent_vector();
+
+  /** @brief Returns the allocator associated with the container. */
+  allocator_type get_allocator() const;
+
+  /** @brief Appends a copy of value, returning the index of its slot.
+   *         Thread-safe. */
+  size_type push_back(const Type &value);
+
+  /** @brief Appends value using move semantics, returning the index of its
+   *         slot. Thread-safe. */
+  size_type push_back(Type &&value);
+
+  /** @brief Appends a new element constructed from args, returning the index
+   *         of its slot. Thread-safe. */
+  template <class... Args> size_type emplace_back(Args &&... args);
+
+  /** @brief Allocates all the segments needed to hold new_cap elements, so
+   *         that pushes don't stall allocating them. Thread-safe. */
+  void reserve(size_type new_cap);
+
+  /** @brief Returns the number of slots claimed so far, including the ones
+   *         still being constructed. Thread-safe. */
+  size_type size() const noexcept;
+
+  /** @brief Checks if no slot has been claimed yet. Thread-safe. */
+  bool empty() const noexcept;
+
+  /** @brief Returns the maximum number of elements the container is able to
+   *         hold. */
+  size_type max_size() const noexcept;
+
+  /** @brief Returns the number of slots in the segments allocated so far,
+   *         counting from the first one. Thread-safe. */
+  size_type capacity() const noexcept;
+
+  /** @brief Returns a reference to the element at slot pos. Its push must have
+   *         finished before the call. Thread-safe. */
+  reference operator[](size_type pos) noexcept;
+  const_reference operator[](size_type pos) const noexcept;
+
+  /** @brief Returns a reference to the element at slot pos, with bounds
+   *         checking. Same as operator[] otherwise. */
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  /** @brief Returns the number of segments spanned by the claimed slots.
+   *         Thread-safe. */
+  size_type segment_count() const noexcept;
+
+  /** @brief Returns the index of the first slot of segment. */
+  static constexpr size_type segment_start(size_type segment) noexcept;
+
+  /** @brief Returns the number of slots in segment. */
+  static constexpr size_type segment_size(size_type segment) noexcept;
+
+  /** @brief Checks whether all of the elements in segment have been
+   *         constructed. Thread-safe. */
+  bool segment_complete(size_type segment) const noexcept;
+
+  /** @brief Returns a pointer to the segment_size(segment) contiguous elements
+   *         of a complete segment, or nullptr if it's not complete.
+   *         Thread-safe. */
+  const Type *segment_data(size_type segment) const noexcept;
+
+  /** @brief Erases all elements and releases the segments. Not thread-safe. */
+  void clear() noexcept;
+
+private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  Allocator allocator_;
+  std::atomic<size_type> size_;
+  std::atomic<Type *> segments_[max_segments];
+  /* number of slots of each segment that are done, constructed or not */
+  std::atomic<size_type> settled_[max_segments];
+  /* slots whose constructor threw, only ever accessed under holes_mutex_ */
+  std::mutex holes_mutex_;
+  ekuvector<size_type> holes_;
+  std::atomic<bool> holed_[max_segments];
+
+  /** @brief Returns the segment holding slot pos. */
+  static size_type segment_of(size_type pos) noexcept;
+
+  /** @brief Returns the address of slot pos, allocating its segment if
+   *         needed. */
+  Type *claim(size_type pos);
+
+  /** @brief Returns a pointer to segment, allocating it if needed. */
+  Type *segment_storage(size_type segment);
+
+  /** @brief Marks slot pos of segment as done, and records it as empty if its
+   *         constructor threw. */
+  void settle(size_type segment, size_type pos, bool constructed) noexcept;
+};
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+constexpr typename ekuconcurrent_vector<Type, Allocator,
+                                        FirstSegment>::size_type
+    ekuconcurrent_vector<Type, Allocator, FirstSegment>::max_segments;
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::ekuconcurrent_vector()
+    : ekuconcurrent_vector(Allocator()) {}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::ekuconcurrent_vector(
+    const Allocator &alloc)
+    : allocator_{alloc}, size_{0} {
+  for (size_type segment = 0; segment < max_segments; ++segment) {
+    segments_[segment].store(nullptr, std::memory_order_relaxed);
+    settled_[segment].store(0, std::memory_order_relaxed);
+    holed_[segment].store(false, std::memory_order_relaxed);
+  }
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::~ekuconcurrent_vector() {
+  clear();
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::allocator_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::get_allocator() const {
+  return allocator_;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::push_back(
+    const Type &value) {
+  return emplace_back(value);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::push_back(Type &&value) {
+  return emplace_back(std::move(value));
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+template <class... Args>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::emplace_back(
+    Args &&... args) {
+  const auto pos = size_.fetch_add(1, std::memory_order_relaxed);
+  const auto segment = segment_of(pos);
+  try {
+    detail::construct(allocator_, claim(pos), std::forward<Args>(args)...);
+  } catch (...) {
+    settle(segment, pos, false);
+    throw;
+  }
+  settle(segment, pos, true);
+  return pos;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+void ekuconcurrent_vector<Type, Allocator, FirstSegment>::reserve(
+    size_type new_cap) {
+  if (new_cap > max_size()) {
+    throw std::length_error("ekuconcurrent_vector::reserve");
+  }
+  for (size_type segment = 0; segment_start(segment) < new_cap; ++segment) {
+    segment_storage(segment);
+  }
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::size() const noexcept {
+  return std::min(size_.load(std::memory_order_relaxed), max_size());
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+bool ekuconcurrent_vector<Type, Allocator, FirstSegment>::empty() const
+    noexcept {
+  return size() == 0;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::max_size() const
+    noexcept {
+  /* the last segment must fit in a single allocation */
+  const auto last_segment =
+      std::min(max_segments - 1,
+               detail::log2_floor(alloc_traits::max_size(allocator_) /
+                                  FirstSegment));
+  return segment_start(last_segment + 1);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::capacity() const
+    noexcept {
+  size_type segment = 0;
+  while (segment < max_segments &&
+         segments_[segment].load(std::memory_order_acquire)) {
+    ++segment;
+  }
+  return segment_start(segment);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::reference
+    ekuconcurrent_vector<Type, Allocator, FirstSegment>::
+    operator[](size_type pos) noexcept {
+  const auto segment = segment_of(pos);
+  return segments_[segment].load(std::memory_order_acquire)
+      [pos - segment_start(segment)];
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::const_reference
+    ekuconcurrent_vector<Type, Allocator, FirstSegment>::
+    operator[](size_type pos) const noexcept {
+  const auto segment = segment_of(pos);
+  return segments_[segment].load(std::memory_order_acquire)
+      [pos - segment_start(segment)];
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::reference
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::at(size_type pos) {
+  if (pos >= size()) {
+    throw std::out_of_range("Out of range access to ekuconcurrent_vector");
+  }
+  return (*this)[pos];
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::const_reference
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::at(size_type pos) const {
+  if (pos >= size()) {
+    throw std::out_of_range("Out of range access to ekuconcurrent_vector");
+  }
+  return (*this)[pos];
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_count() const
+    noexcept {
+  const auto count = size();
+  return count ? segment_of(count - 1) + 1 : 0;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+constexpr typename ekuconcurrent_vector<Type, Allocator,
+                                        FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_start(
+    size_type segment) noexcept {
+  /* segment k spans [F * (2^k - 1), F * (2^(k+1) - 1)) */
+  return FirstSegment * ((size_type{1} << segment) - 1);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+constexpr typename ekuconcurrent_vector<Type, Allocator,
+                                        FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_size(
+    size_type segment) noexcept {
+  return FirstSegment << segment;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+bool ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_complete(
+    size_type segment) const noexcept {
+  return segment < max_segments &&
+         settled_[segment].load(std::memory_order_acquire) ==
+             segment_size(segment) &&
+         !holed_[segment].load(std::memory_order_relaxed);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+const Type *
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_data(
+    size_type segment) const noexcept {
+  return segment_complete(segment)
+             ? segments_[segment].load(std::memory_order_acquire)
+             : nullptr;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+void ekuconcurrent_vector<Type, Allocator, FirstSegment>::clear() noexcept {
+  const auto count = size();
+  std::sort(holes_.begin(), holes_.end());
+  auto hole = holes_.cbegin();
+  for (size_type segment = 0; segment < max_segments; ++segment) {
+    auto storage = segments_[segment].load(std::memory_order_relaxed);
+    if (!storage) {
+      continue;
+    }
+    const auto start = segment_start(segment);
+    const auto end = std::min(count, start + segment_size(segment));
+    for (auto pos = start; pos < end; ++pos) {
+      while (hole != holes_.cend() && *hole < pos) {
+        ++hole;
+      }
+      if (hole != holes_.cend() && *hole == pos) {
+        ++hole;
+        continue;
+      }
+      detail::destroy(allocator_, storage + (pos - start));
+    }
+    alloc_traits::deallocate(allocator_, storage, segment_size(segment));
+    segments_[segment].store(nullptr, std::memory_order_relaxed);
+    settled_[segment].store(0, std::memory_order_relaxed);
+    holed_[segment].store(false, std::memory_order_relaxed);
+  }
+  holes_.clear();
+  size_.store(0, std::memory_order_relaxed);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+typename ekuconcurrent_vector<Type, Allocator, FirstSegment>::size_type
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_of(
+    size_type pos) noexcept {
+  return detail::log2_floor(pos / FirstSegment + 1);
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+Type *
+ekuconcurrent_vector<Type, Allocator, FirstSegment>::claim(size_type pos) {
+  if (pos >= max_size()) {
+    throw std::length_error("ekuconcurrent_vector::emplace_back");
+  }
+  const auto segment = segment_of(pos);
+  return segment_storage(segment) + (pos - segment_start(segment));
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+Type *ekuconcurrent_vector<Type, Allocator, FirstSegment>::segment_storage(
+    size_type segment) {
+  auto storage = segments_[segment].load(std::memory_order_acquire);
+  if (storage) {
+    return storage;
+  }
+  /* racing producers may both allocate, only one of them gets to publish */
+  auto fresh = alloc_traits::allocate(allocator_, segment_size(segment));
+  if (segments_[segment].compare_exchange_strong(storage, fresh,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+    return fresh;
+  }
+  alloc_traits::deallocate(allocator_, fresh, segment_size(segment));
+  return storage;
+}
+
+template <class Type, class Allocator, std::size_t FirstSegment>
+void ekuconcurrent_vector<Type, Allocator, FirstSegment>::settle(
+    size_type segment, size_type pos, bool constructed) noexcept {
+  if (segment >= max_segments) {
+    /* slots past max_size() have no storage at all */
+    return;
+  }
+  if (!constructed) {
+    holed_[segment].store(true, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(holes_mutex_);
+    try {
+      holes_.push_back(pos);
+    } catch (...) {
+      /* without a record of the hole the destructor would run on it */
+      std::terminate();
+    }
+  }
+  settled_[segment].fetch_add(1, std::memory_order_release);
+}
+
+}; // namespace ekustd
@@ -0,0 +1,845 @@
+/**
+ * ekucow_vector, copy-on-write ekuvector for read-mostly data.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief Vector whose copies share a single reference counted buffer, until
+ *         one of them gets modified.
+ *
+ * Copying is O(1), and only bumps the atomic reference count of the buffer, so
+ * the same contents can be fanned out to many threads. The first modifying
+ * call on a container that shares its buffer detaches it, copying the
+ * contents into a buffer of its own. Const members never copy.
+ *
+ * Non-const members handing out references, pointers or iterators to the
+ * elements (operator[], at(), data(), begin(), insert(), ...) mark the buffer
+ * as unshareable, so that writes through them can't leak into copies made
+ * afterwards: copies of such a container are deep copies. The buffer becomes
+ * shareable again when all the references are invalidated, by assigning new
+ * contents or clearing the container.
+ *
+ * As with any other container, a single ekucow_vector object must not be
+ * accessed from several threads if any of them modifies it, but distinct
+ * copies sharing a buffer can be used freely from different threads. */
+template <class Type, class Allocator = std::allocator<Type>,
+          class Growth = geometric_growth<>>
+class ekucow_vector {
+public:
+  using vector_type = ekuvector<Type, Allocator, Growth>;
+
+  using type = Type;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = Type;
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
+
+  using pointer = Type *;
+  using const_pointer = const Type *;
+
+  using iterator = Type *;
+  using const_iterator = const Type *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /** @brief Default constructor. Constructs an empty container, which doesn't
+   *         allocate a buffer until it gets elements. */
+  ekucow_vector();
+
+  /** @brief Constructs an empty container with the given allocator alloc. */
+  explicit ekucow_vector(const Allocator &alloc);
+
+  /** @brief Constructs the container with count default-inserted instances of
+   *         Type. */
+  ekucow_vector(size_type count);
+
+  /** @brief Constructs the container with count copies of value. */
+  ekucow_vector(size_type count, const Type &value,
+                const Allocator &alloc = Allocator());
+
+  /** @brief Constructs the container with the contents of the range [first,
+   *         last). */
+  template <class InputIt>
+  ekucow_vector(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
+      const Allocator &alloc = Allocator());
+
+  /** @brief Constructs the container with the contents of the initializer list
+   *         init. */
+  ekucow_vector(std::initializer_list<Type> init,
+                const Allocator &alloc = Allocator());
+
+  /** @brief Constructs the container taking over the contents of vector. */
+  explicit ekucow_vector(vector_type vector);
+
+  /** @brief Copy constructor. Shares the buffer of other, unless other has
+   *         handed out mutable references to it. */
+  ekucow_vector(const ekucow_vector &other);
+
+  /** @brief Move constructor. Takes over the buffer of other, which is left
+   *         empty. */
+  ekucow_vector(ekucow_vector &&other) noexcept;
+
+  /** @brief Copy assignment operator. Shares the buffer of other, unless other
+   *         has handed out mutable references to it. */
+  ekucow_vector &operator=(const ekucow_vector &other);
+
+  /** @brief Move assignment operator. Takes over the buffer of other, which is
+   *         left empty. */
+  ekucow_vector &operator=(ekucow_vector &&other) noexcept;
+
+  /** @brief Replaces the contents with those of the initializer list ilist. */
+  ekucow_vector &operator=(std::initializer_list<Type> ilist);
+
+  /** @brief Replaces the contents with count copies of value. */
+  void assign(size_type count, const Type &value);
+
+  /** @brief Replaces the contents with copies of those in the range [first,
+   *         last). */
+  template <class InputIt>
+  void assign(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Replaces the contents with the elements of the initializer list
+   *         ilist. */
+  void assign(std::initializer_list<Type> ilist);
+
+  /** @brief Returns the allocator associated with the container. */
+  allocator_type get_allocator() const;
+
+  /** @brief Returns the number of containers sharing the buffer of this one,
+   *         or zero if it has no buffer. */
+  long use_count() const noexcept;
+
+  /** @brief Checks whether the buffer is shared with other containers. */
+  bool is_shared() const noexcept;
+
+  /** @brief Returns a reference to the element at specified location pos, with
+   *         bounds checking. The non-const overload detaches the buffer. */
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  /** @brief Returns a reference to the element at specified location pos. No
+   *         bounds checking is performed. The non-const overload detaches the
+   *         buffer. */
+  reference operator[](size_type pos);
+  const_reference operator[](size_type pos) const;
+
+  /** @brief Returns a reference to the first element in the container. */
+  reference front();
+  const_reference front() const;
+
+  /** @brief Returns reference to the last element in the container. */
+  reference back();
+  const_reference back() const;
+
+  /** @brief Returns pointer to the underlying array serving as element storage.
+   *         The non-const overload detaches the buffer. */
+  Type *data();
+  const Type *data() const noexcept;
+
+  /** @brief Iterators to the beginning of the container. The non-const
+   *         overload detaches the buffer. */
+  iterator begin();
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  /** @brief Iterators to the end of the container. */
+  iterator end();
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  /** @brief Reverse iterators to the beginning of the reversed container. */
+  reverse_iterator rbegin();
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator crbegin() const noexcept;
+
+  /** @brief Reverse iterators to the end of the reversed container. */
+  reverse_iterator rend();
+  const_reverse_iterator rend() const noexcept;
+  const_reverse_iterator crend() const noexcept;
+
+  /** @brief Checks if the container has no elements. */
+  bool empty() const noexcept;
+
+  /** @brief Returns the number of elements in the container. */
+  size_type size() const noexcept;
+
+  /** @brief Returns the maximum number of elements the container is able to
+   *         hold. */
+  size_type max_size() const noexcept;
+
+  /** @brief Increases the capacity to a value that's greater or equal to
+   *         new_cap. */
+  void reserve(size_type new_cap);
+
+  /** @brief Returns the number of elements that the buffer has currently
+   *         allocated space for. */
+  size_type capacity() const noexcept;
+
+  /** @brief Requests the removal of unused capacity. */
+  void shrink_to_fit();
+
+  /** @brief Erases all elements from the container. A shared buffer is just
+   *         released, without copying anything. */
+  void clear() noexcept;
+
+  /** @brief Inserts value before pos. */
+  iterator insert(const_iterator pos, const Type &value);
+  iterator insert(const_iterator pos, Type &&value);
+
+  /** @brief Inserts count copies of value before pos. */
+  iterator insert(const_iterator pos, size_type count, const Type &value);
+
+  /** @brief Inserts elements from the range [first, last) before pos. */
+  template <class InputIt>
+  iterator insert(
+      const_iterator pos, InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Inserts elements from initializer list ilist before pos. */
+  iterator insert(const_iterator pos, std::initializer_list<Type> ilist);
+
+  /** @brief Inserts a new element constructed from args directly before
+   *         pos. */
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&... args);
+
+  /** @brief Removes the element at pos. */
+  iterator erase(const_iterator pos);
+
+  /** @brief Removes the elements in the range [first, last). */
+  iterator erase(const_iterator first, const_iterator last);
+
+  /** @brief Appends the given element value to the end of the container. */
+  void push_back(const Type &value);
+  void push_back(Type &&value);
+
+  /** @brief Appends a new element constructed from args to the end of the
+   *         container. */
+  template <class... Args> void emplace_back(Args &&... args);
+
+  /** @brief Removes the last element of the container. */
+  void pop_back();
+
+  /** @brief Resizes the container to contain count elements, appending
+   *         default-inserted elements if needed. */
+  void resize(size_type count);
+
+  /** @brief Resizes the container to contain count elements, appending copies
+   *         of value if needed. */
+  void resize(size_type count, const value_type &value);
+
+  /** @brief Exchanges the contents of the container with those of other. */
+  void swap(ekucow_vector &other) noexcept;
+
+private:
+  Allocator allocator_;
+  std::shared_ptr<vector_type> buffer_;
+  bool shareable_;
+
+  /** @brief Returns a buffer owned by this container alone, copying the
+   *         contents of the current one if it's shared. */
+  vector_type &writable();
+
+  /** @brief Same as writable(), but also marks the buffer as unshareable,
+   *         since references to its elements are about to be handed out. */
+  vector_type &leak();
+
+  /** @brief Returns a new buffer holding a copy of the contents of this
+   *         container. */
+  std::shared_ptr<vector_type> clone() const;
+
+  /** @brief Returns a new buffer with room for new_cap elements, holding a
+   *         copy of the first count elements of this container. Used instead
+   *         of writable() when most of a shared buffer would be copied only
+   *         to be overwritten or dropped. */
+  std::shared_ptr<vector_type> clone_prefix(size_type count,
+                                            size_type new_cap) const;
+};
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector()
+    : ekucow_vector(Allocator()) {}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(const Allocator &alloc)
+    : allocator_{alloc}, buffer_{}, shareable_{true} {}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(size_type count)
+    : ekucow_vector() {
+  resize(count);
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(size_type count,
+                                                      const Type &value,
+                                                      const Allocator &alloc)
+    : ekucow_vector(alloc) {
+  assign(count, value);
+}
+
+template <class Type, class Allocator, class Growth>
+template <class InputIt>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
+    const Allocator &alloc)
+    : ekucow_vector(alloc) {
+  assign(first, last);
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(
+    std::initializer_list<Type> init, const Allocator &alloc)
+    : ekucow_vector(alloc) {
+  assign(init);
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(vector_type vector)
+    : ekucow_vector(vector.get_allocator()) {
+  buffer_ = std::allocate_shared<vector_type>(allocator_, std::move(vector));
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(
+    const ekucow_vector &other)
+    : allocator_{std::allocator_traits<Allocator>::
+                     select_on_container_copy_construction(other.allocator_)},
+      buffer_{other.shareable_ ? other.buffer_ : other.clone()},
+      shareable_{true} {}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth>::ekucow_vector(
+    ekucow_vector &&other) noexcept
+    : allocator_{std::move(other.allocator_)},
+      buffer_{std::move(other.buffer_)}, shareable_{other.shareable_} {
+  other.shareable_ = true;
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth> &
+ekucow_vector<Type, Allocator, Growth>::operator=(const ekucow_vector &other) {
+  if (this != &other) {
+    buffer_ = other.shareable_ ? other.buffer_ : other.clone();
+    shareable_ = true;
+  }
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth> &
+ekucow_vector<Type, Allocator, Growth>::operator=(
+    ekucow_vector &&other) noexcept {
+  if (this != &other) {
+    buffer_ = std::move(other.buffer_);
+    shareable_ = other.shareable_;
+    other.shareable_ = true;
+  }
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth>
+ekucow_vector<Type, Allocator, Growth> &
+ekucow_vector<Type, Allocator, Growth>::
+operator=(std::initializer_list<Type> ilist) {
+  assign(ilist);
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::assign(size_type count,
+                                                    const Type &value) {
+  if (is_shared()) {
+    /* value may come from the shared buffer, which must be kept alive until
+       it's been copied */
+    auto buffer = std::allocate_shared<vector_type>(allocator_, count, value,
+                                                    allocator_);
+    buffer_ = std::move(buffer);
+  } else {
+    writable().assign(count, value);
+  }
+  shareable_ = true;
+}
+
+template <class Type, class Allocator, class Growth>
+template <class InputIt>
+void ekucow_vector<Type, Allocator, Growth>::assign(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  if (is_shared()) {
+    /* the range may come from the shared buffer, which must be kept alive
+       until it's been copied */
+    auto buffer =
+        std::allocate_shared<vector_type>(allocator_, first, last, allocator_);
+    buffer_ = std::move(buffer);
+  } else {
+    writable().assign(first, last);
+  }
+  shareable_ = true;
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::assign(
+    std::initializer_list<Type> ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::allocator_type
+ekucow_vector<Type, Allocator, Growth>::get_allocator() const {
+  return allocator_;
+}
+
+template <class Type, class Allocator, class Growth>
+long ekucow_vector<Type, Allocator, Growth>::use_count() const noexcept {
+  return buffer_.use_count();
+}
+
+template <class Type, class Allocator, class Growth>
+bool ekucow_vector<Type, Allocator, Growth>::is_shared() const noexcept {
+  return use_count() > 1;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::reference
+ekucow_vector<Type, Allocator, Growth>::at(size_type pos) {
+  if (pos >= size()) {
+    throw std::out_of_range("Out of range access to ekucow_vector");
+  }
+  return leak()[pos];
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reference
+ekucow_vector<Type, Allocator, Growth>::at(size_type pos) const {
+  if (pos >= size()) {
+    throw std::out_of_range("Out of range access to ekucow_vector");
+  }
+  return data()[pos];
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::reference
+    ekucow_vector<Type, Allocator, Growth>::operator[](size_type pos) {
+  return leak()[pos];
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reference
+    ekucow_vector<Type, Allocator, Growth>::operator[](size_type pos) const {
+  return data()[pos];
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::reference
+ekucow_vector<Type, Allocator, Growth>::front() {
+  return leak().front();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reference
+ekucow_vector<Type, Allocator, Growth>::front() const {
+  return *data();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::reference
+ekucow_vector<Type, Allocator, Growth>::back() {
+  return leak().back();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reference
+ekucow_vector<Type, Allocator, Growth>::back() const {
+  return data()[size() - 1];
+}
+
+template <class Type, class Allocator, class Growth>
+Type *ekucow_vector<Type, Allocator, Growth>::data() {
+  return leak().data();
+}
+
+template <class Type, class Allocator, class Growth>
+const Type *ekucow_vector<Type, Allocator, Growth>::data() const noexcept {
+  return buffer_ ? static_cast<const vector_type &>(*buffer_).data() : nullptr;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::begin() {
+  return leak().data();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_iterator
+ekucow_vector<Type, Allocator, Growth>::begin() const noexcept {
+  return data();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_iterator
+ekucow_vector<Type, Allocator, Growth>::cbegin() const noexcept {
+  return data();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::end() {
+  auto &buffer = leak();
+  return buffer.data() + buffer.size();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_iterator
+ekucow_vector<Type, Allocator, Growth>::end() const noexcept {
+  return data() + size();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_iterator
+ekucow_vector<Type, Allocator, Growth>::cend() const noexcept {
+  return data() + size();
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::reverse_iterator
+ekucow_vector<Type, Allocator, Growth>::rbegin() {
+  return reverse_iterator(end());
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reverse_iterator
+ekucow_vector<Type, Allocator, Growth>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reverse_iterator
+ekucow_vector<Type, Allocator, Growth>::crbegin() const noexcept {
+  return const_reverse_iterator(cend());
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::reverse_iterator
+ekucow_vector<Type, Allocator, Growth>::rend() {
+  return reverse_iterator(begin());
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reverse_iterator
+ekucow_vector<Type, Allocator, Growth>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::const_reverse_iterator
+ekucow_vector<Type, Allocator, Growth>::crend() const noexcept {
+  return const_reverse_iterator(cbegin());
+}
+
+template <class Type, class Allocator, class Growth>
+bool ekucow_vector<Type, Allocator, Growth>::empty() const noexcept {
+  return size() == 0;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::size_type
+ekucow_vector<Type, Allocator, Growth>::size() const noexcept {
+  return buffer_ ? buffer_->size() : 0;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::size_type
+ekucow_vector<Type, Allocator, Growth>::max_size() const noexcept {
+  return vector_type(allocator_).max_size();
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::reserve(size_type new_cap) {
+  if (new_cap > capacity()) {
+    writable().reserve(new_cap);
+  }
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::size_type
+ekucow_vector<Type, Allocator, Growth>::capacity() const noexcept {
+  return buffer_ ? buffer_->capacity() : 0;
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::shrink_to_fit() {
+  if (buffer_ && (buffer_->size() < buffer_->capacity())) {
+    writable().shrink_to_fit();
+  }
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::clear() noexcept {
+  if (is_shared()) {
+    buffer_.reset();
+  } else if (buffer_) {
+    buffer_->clear();
+  }
+  shareable_ = true;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::insert(const_iterator pos,
+                                               const Type &value) {
+  /* pos may point into a shared buffer, which is about to be left behind */
+  const auto ordinal = pos - cbegin();
+  auto &buffer = leak();
+  buffer.insert(buffer.cbegin() + ordinal, value);
+  return buffer.data() + ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::insert(const_iterator pos,
+                                               Type &&value) {
+  const auto ordinal = pos - cbegin();
+  auto &buffer = leak();
+  buffer.insert(buffer.cbegin() + ordinal, std::move(value));
+  return buffer.data() + ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::insert(const_iterator pos,
+                                               size_type count,
+                                               const Type &value) {
+  const auto ordinal = pos - cbegin();
+  auto &buffer = leak();
+  buffer.insert(buffer.cbegin() + ordinal, count, value);
+  return buffer.data() + ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+template <class InputIt>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::insert(
+    const_iterator pos, InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  const auto ordinal = pos - cbegin();
+  auto &buffer = leak();
+  buffer.insert(buffer.cbegin() + ordinal, first, last);
+  return buffer.data() + ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::insert(
+    const_iterator pos, std::initializer_list<Type> ilist) {
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+template <class Type, class Allocator, class Growth>
+template <class... Args>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::emplace(const_iterator pos,
+                                                Args &&... args) {
+  const auto ordinal = pos - cbegin();
+  auto &buffer = leak();
+  buffer.emplace(buffer.cbegin() + ordinal, std::forward<Args>(args)...);
+  return buffer.data() + ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::erase(const_iterator pos) {
+  const auto ordinal = pos - cbegin();
+  auto &buffer = leak();
+  buffer.erase(buffer.cbegin() + ordinal);
+  return buffer.data() + ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::iterator
+ekucow_vector<Type, Allocator, Growth>::erase(const_iterator first,
+                                              const_iterator last) {
+  const auto first_ordinal = first - cbegin();
+  const auto last_ordinal = last - cbegin();
+  auto &buffer = leak();
+  buffer.erase(buffer.cbegin() + first_ordinal, buffer.cbegin() + last_ordinal);
+  return buffer.data() + first_ordinal;
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::push_back(const Type &value) {
+  writable().push_back(value);
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::push_back(Type &&value) {
+  writable().push_back(std::move(value));
+}
+
+template <class Type, class Allocator, class Growth>
+template <class... Args>
+void ekucow_vector<Type, Allocator, Growth>::emplace_back(Args &&... args) {
+  writable().emplace_back(std::forward<Args>(args)...);
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::pop_back() {
+  writable().pop_back();
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::resize(size_type count) {
+  if (count == size()) {
+    return;
+  }
+  if (is_shared()) {
+    auto buffer = clone_prefix(std::min(count, size()), count);
+    buffer->resize(count);
+    buffer_ = std::move(buffer);
+  } else {
+    writable().resize(count);
+  }
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::resize(size_type count,
+                                                    const value_type &value) {
+  if (count == size()) {
+    return;
+  }
+  if (is_shared()) {
+    /* value may come from the shared buffer, which stays alive until the new
+       one is complete */
+    auto buffer = clone_prefix(std::min(count, size()), count);
+    buffer->resize(count, value);
+    buffer_ = std::move(buffer);
+  } else {
+    writable().resize(count, value);
+  }
+}
+
+template <class Type, class Allocator, class Growth>
+void ekucow_vector<Type, Allocator, Growth>::swap(
+    ekucow_vector &other) noexcept {
+  detail::swap_allocators(allocator_, other.allocator_,
+                          typename std::allocator_traits<
+                              Allocator>::propagate_on_container_swap{});
+  buffer_.swap(other.buffer_);
+  std::swap(shareable_, other.shareable_);
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::vector_type &
+ekucow_vector<Type, Allocator, Growth>::writable() {
+  if (!buffer_) {
+    buffer_ = std::allocate_shared<vector_type>(allocator_, allocator_);
+  } else if (buffer_.use_count() != 1) {
+    buffer_ = clone();
+  } else {
+    /* the last reads through copies released in other threads must happen
+       before the writes about to be done to the buffer */
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *buffer_;
+}
+
+template <class Type, class Allocator, class Growth>
+typename ekucow_vector<Type, Allocator, Growth>::vector_type &
+ekucow_vector<Type, Allocator, Growth>::leak() {
+  auto &buffer = writable();
+  shareable_ = false;
+  return buffer;
+}
+
+template <class Type, class Allocator, class Growth>
+std::shared_ptr<typename ekucow_vector<Type, Allocator, Growth>::vector_type>
+ekucow_vector<Type, Allocator, Growth>::clone() const {
+  if (!buffer_) {
+    return nullptr;
+  }
+  return std::allocate_shared<vector_type>(allocator_, *buffer_, allocator_);
+}
+
+template <class Type, class Allocator, class Growth>
+std::shared_ptr<typename ekucow_vector<Type, Allocator, Growth>::vector_type>
+ekucow_vector<Type, Allocator, Growth>::clone_prefix(size_type count,
+                                                     size_type new_cap) const {
+  auto buffer = std::allocate_shared<vector_type>(allocator_, allocator_);
+  buffer->reserve(new_cap);
+  buffer->assign(buffer_->cbegin(), buffer_->cbegin() + count);
+  return buffer;
+}
+
+/*
+ * *** NON MEMBERS ***
+ * */
+
+template <class Type, class Alloc, class Growth>
+bool operator==(const ekucow_vector<Type, Alloc, Growth> &lhs,
+                const ekucow_vector<Type, Alloc, Growth> &rhs) {
+  return detail::equal_contents(lhs.data(), lhs.size(), rhs.data(),
+                                rhs.size());
+}
+
+template <class Type, class Alloc, class Growth>
+bool operator!=(const ekucow_vector<Type, Alloc, Growth> &lhs,
+                const ekucow_vector<Type, Alloc, Growth> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class Type, class Alloc, class Growth>
+bool operator<(const ekucow_vector<Type, Alloc, Growth> &lhs,
+               const ekucow_vector<Type, Alloc, Growth> &rhs) {
+  return detail::less_contents(lhs.data(), lhs.size(), rhs.data(),
+                               rhs.size());
+}
+
+template <class Type, class Alloc, class Growth>
+bool operator<=(const ekucow_vector<Type, Alloc, Growth> &lhs,
+                const ekucow_vector<Type, Alloc, Growth> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <class Type, class Alloc, class Growth>
+bool operator>(const ekucow_vector<Type, Alloc, Growth> &lhs,
+               const ekucow_vector<Type, Alloc, Growth> &rhs) {
+  return rhs < lhs;
+}
+
+template <class Type, class Alloc, class Growth>
+bool operator>=(const ekucow_vector<Type, Alloc, Growth> &lhs,
+                const ekucow_vector<Type, Alloc, Growth> &rhs) {
+  return !(lhs < rhs);
+}
+
+template <class Type, class Alloc, class Growth>
+void swap(ekucow_vector<Type, Alloc, Growth> &lhs,
+          ekucow_vector<Type, Alloc, Growth> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}; // namespace ekustd
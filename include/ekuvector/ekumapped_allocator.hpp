@@ -0,0 +1,376 @@
+/**
+ * ekumapped_allocator, file-backed storage for persistent ekuvectors.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief File holding an array of elements, mapped into memory.
+ *
+ * The first page of the file is a header recording the size of the elements
+ * and the number of them in use, and the elements follow right after it, so
+ * that the mapping of the array is page-aligned. At most one block of the
+ * array can be mapped at a time: it grows and shrinks along with the file,
+ * using mremap() where available, so the contents are never copied.
+ *
+ * Changes reach the file through the page cache, even if the process dies, but
+ * they are only guaranteed to survive a system crash after sync(). */
+class ekumapped_file {
+public:
+  /** @brief Opens the file at path, creating it if it doesn't exist.
+   *
+   * Throws std::system_error if the file can't be opened, and
+   * std::runtime_error if it doesn't hold elements of element_size bytes. */
+  ekumapped_file(const std::string &path, std::size_t element_size)
+      : fd_{::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)},
+        page_size_{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))},
+        header_{nullptr}, block_{nullptr}, block_bytes_{0} {
+    if (fd_ < 0) {
+      throw_errno("can't open " + path);
+    }
+    try {
+      const auto fresh = file_length() < page_size_;
+      if (fresh) {
+        resize_file(page_size_);
+      }
+      auto header = ::mmap(nullptr, page_size_, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd_, 0);
+      if (header == MAP_FAILED) {
+        throw_errno("can't map the header of " + path);
+      }
+      header_ = static_cast<file_header *>(header);
+      if (fresh) {
+        header_->magic = magic;
+        header_->element_size = element_size;
+        header_->size = 0;
+      }
+      if (header_->magic != magic) {
+        throw std::runtime_error(path + " is not an ekumapped_file");
+      }
+      if (header_->element_size != element_size) {
+        throw std::runtime_error(path + " holds elements of another size");
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  ekumapped_file(const ekumapped_file &) = delete;
+  ekumapped_file &operator=(const ekumapped_file &) = delete;
+
+  /** @brief Destructor. Unmaps the header and closes the file. */
+  ~ekumapped_file() { release(); }
+
+  /** @brief Returns the number of elements in use, as last stored. */
+  std::size_t stored_size() const noexcept {
+    return static_cast<std::size_t>(header_->size);
+  }
+
+  /** @brief Records size as the number of elements in use. */
+  void store_size(std::size_t size) noexcept { header_->size = size; }
+
+  /** @brief Returns the number of elements the file has room for. */
+  std::size_t stored_capacity() const {
+    return (file_length() - page_size_) / header_->element_size;
+  }
+
+  /** @brief Maps the first bytes of the array. Throws std::bad_alloc if a
+   *         block is already mapped, or if the mapping fails. */
+  void *map(std::size_t bytes) {
+    if (block_) {
+      throw std::bad_alloc();
+    }
+    grow_file(bytes);
+    auto block = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        fd_, static_cast<off_t>(page_size_));
+    if (block == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    block_ = block;
+    block_bytes_ = bytes;
+    return block;
+  }
+
+  /** @brief Resizes the mapped block to new_bytes, keeping its contents and
+   *         possibly moving it. Throws std::bad_alloc on failure, leaving the
+   *         block untouched. */
+  void *remap(void *block, std::size_t new_bytes) {
+    if (block != block_) {
+      throw std::bad_alloc();
+    }
+    grow_file(new_bytes);
+#ifdef MREMAP_MAYMOVE
+    auto resized = ::mremap(block_, block_bytes_, new_bytes, MREMAP_MAYMOVE);
+#else
+    /* the contents live in the file, so mapping it again loses nothing */
+    auto resized = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd_, static_cast<off_t>(page_size_));
+    if (resized != MAP_FAILED) {
+      ::munmap(block_, block_bytes_);
+    }
+#endif
+    if (resized == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    if (new_bytes < block_bytes_) {
+      /* give the tail back to the file system. A failure leaves the file as
+         it was, which is still consistent */
+      if (::ftruncate(fd_, static_cast<off_t>(page_size_ + new_bytes)) != 0) {
+        errno = 0;
+      }
+    }
+    block_ = resized;
+    block_bytes_ = new_bytes;
+    return resized;
+  }
+
+  /** @brief Unmaps the block mapped by map() or remap(). The file keeps its
+   *         contents. */
+  void unmap(void *block) noexcept {
+    if (block && (block == block_)) {
+      ::munmap(block_, block_bytes_);
+      block_ = nullptr;
+      block_bytes_ = 0;
+    }
+  }
+
+  /** @brief Writes the header and the mapped block back to the file, and
+   *         waits for the writes to complete. Throws std::system_error on
+   *         failure. */
+  void sync() {
+    if (block_ && ::msync(block_, block_bytes_, MS_SYNC) != 0) {
+      throw_errno("can't sync the elements");
+    }
+    if (::msync(header_, page_size_, MS_SYNC) != 0) {
+      throw_errno("can't sync the header");
+    }
+  }
+
+private:
+  struct file_header {
+    std::uint64_t magic;
+    std::uint64_t element_size;
+    std::uint64_t size;
+  };
+
+  /* "EKUMAPV1" */
+  static constexpr std::uint64_t magic = 0x45'4b'55'4d'41'50'56'31;
+
+  int fd_;
+  std::size_t page_size_;
+  file_header *header_;
+  void *block_;
+  std::size_t block_bytes_;
+
+  [[noreturn]] static void throw_errno(const std::string &what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  std::size_t file_length() const {
+    struct stat status;
+    if (::fstat(fd_, &status) != 0) {
+      throw_errno("can't stat the file");
+    }
+    return static_cast<std::size_t>(status.st_size);
+  }
+
+  void resize_file(std::size_t length) {
+    if (::ftruncate(fd_, static_cast<off_t>(length)) != 0) {
+      throw_errno("can't resize the file");
+    }
+  }
+
+  /* makes room for bytes of elements, but never shrinks the file, which may
+     hold elements past the block being mapped */
+  void grow_file(std::size_t bytes) {
+    if (file_length() < page_size_ + bytes) {
+      try {
+        resize_file(page_size_ + bytes);
+      } catch (const std::system_error &) {
+        throw std::bad_alloc();
+      }
+    }
+  }
+
+  void release() noexcept {
+    unmap(block_);
+    if (header_) {
+      ::munmap(header_, page_size_);
+      header_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+};
+
+constexpr std::uint64_t ekumapped_file::magic;
+
+/** @brief Allocator whose single block is the array of an ekumapped_file.
+ *
+ * Only one block can be live at a time, so copies of a container using it must
+ * use another allocator. The file must outlive every allocator using it.
+ * Growth goes through reallocate(), which resizes the mapping in place. */
+template <class Type> class ekumapped_allocator {
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "only trivially copyable types can be stored in a file");
+
+public:
+  using value_type = Type;
+  using pointer = Type *;
+  using const_pointer = const Type *;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+  template <class Other> struct rebind {
+    using other = ekumapped_allocator<Other>;
+  };
+
+  /** @brief Constructs an allocator that maps the array of file. */
+  ekumapped_allocator(ekumapped_file &file) noexcept : file_{&file} {}
+
+  template <class Other>
+  ekumapped_allocator(const ekumapped_allocator<Other> &other) noexcept
+      : file_{other.file_} {}
+
+  Type *allocate(std::size_t n) {
+    return static_cast<Type *>(file_->map(n * sizeof(Type)));
+  }
+
+  void deallocate(Type *p, std::size_t /* n */) noexcept {
+    file_->unmap(static_cast<void *>(p));
+  }
+
+  /** @brief Resizes the block p to new_n elements, keeping its contents. */
+  Type *reallocate(Type *p, std::size_t /* old_n */, std::size_t new_n) {
+    return static_cast<Type *>(
+        file_->remap(static_cast<void *>(p), new_n * sizeof(Type)));
+  }
+
+  /** @brief Returns the file this allocator maps. */
+  ekumapped_file &file() const noexcept { return *file_; }
+
+private:
+  template <class Other> friend class ekumapped_allocator;
+
+  ekumapped_file *file_;
+};
+
+template <class Type, class Other>
+bool operator==(const ekumapped_allocator<Type> &lhs,
+                const ekumapped_allocator<Other> &rhs) noexcept {
+  return &lhs.file() == &rhs.file();
+}
+
+template <class Type, class Other>
+bool operator!=(const ekumapped_allocator<Type> &lhs,
+                const ekumapped_allocator<Other> &rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+namespace detail {
+
+/* lets ekumapped_vector open its file before its ekuvector base gets
+   constructed */
+class mapped_file_holder {
+protected:
+  mapped_file_holder(const std::string &path, std::size_t element_size)
+      : file_{path, element_size} {}
+
+  ekumapped_file file_;
+};
+
+} // namespace detail
+
+/** @brief ekuvector stored in a file, which persists its contents between
+ *         runs.
+ *
+ * Opening a file maps the elements stored in it, without reading or copying
+ * them, and the vector is usable right away. Growth resizes the file and the
+ * mapping in place. The size is recorded in the header of the file by sync()
+ * and by the destructor. */
+template <class Type, class Growth = page_aligned_growth<>>
+class ekumapped_vector
+    : private detail::mapped_file_holder,
+      public ekuvector<Type, ekumapped_allocator<Type>, Growth> {
+public:
+  using vector_type = ekuvector<Type, ekumapped_allocator<Type>, Growth>;
+
+  /** @brief Opens the file at path, creating it if needed, and maps the
+   *         elements stored in it. */
+  explicit ekumapped_vector(const std::string &path);
+
+  ekumapped_vector(const ekumapped_vector &) = delete;
+  ekumapped_vector &operator=(const ekumapped_vector &) = delete;
+
+  /** @brief Destructor. Records the size in the file, and unmaps it. */
+  ~ekumapped_vector();
+
+  /** @brief Records the size in the file, and waits until the file holds the
+   *         current contents. */
+  void sync();
+
+  /** @brief Returns the file holding the elements. */
+  ekumapped_file &file() noexcept;
+};
+
+template <class Type, class Growth>
+ekumapped_vector<Type, Growth>::ekumapped_vector(const std::string &path)
+    : detail::mapped_file_holder(path, sizeof(Type)),
+      vector_type(ekumapped_allocator<Type>(file_)) {
+  const auto stored_size = file_.stored_size();
+  if (stored_size) {
+    /* the elements are already there, just hand them to the vector */
+    const auto capacity = std::max(stored_size, file_.stored_capacity());
+    this->adopt(this->get_allocator().allocate(capacity), stored_size,
+                capacity);
+  }
+}
+
+template <class Type, class Growth>
+ekumapped_vector<Type, Growth>::~ekumapped_vector() {
+  file_.store_size(this->size());
+}
+
+template <class Type, class Growth>
+void ekumapped_vector<Type, Growth>::sync() {
+  file_.store_size(this->size());
+  file_.sync();
+}
+
+template <class Type, class Growth>
+ekumapped_file &ekumapped_vector<Type, Growth>::file() noexcept {
+  return file_;
+}
+
+}; // namespace ekustd
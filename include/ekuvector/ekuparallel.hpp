@@ -0,0 +1,159 @@
+/**
+ * ekuparallel_policy, execution policy splitting bulk ekuvector operations
+ * across threads.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief Execution policy that runs each chunk of a bulk operation on a
+ *         thread of its own.
+ *
+ * The work is split in at most threads() chunks of consecutive elements, none
+ * of them smaller than grain() elements, and the calling thread takes the
+ * first one. Operations too small to fill two chunks run serially, without
+ * starting any threads. If threads can't be started, their chunks are run
+ * by the calling thread instead.
+ *
+ * Threads are started per operation, which is only worth it for operations
+ * taking well over the time needed to start them. Thread pools can be used by
+ * writing a policy of their own (see is_execution_policy). */
+class ekuparallel_policy {
+public:
+  /** @brief Default minimum number of elements in a chunk. */
+  static constexpr std::size_t default_grain = 32 * 1024;
+
+  /** @brief Constructs the policy. A threads count of zero stands for the
+   *         number of hardware threads. */
+  explicit ekuparallel_policy(std::size_t threads = 0,
+                              std::size_t grain = default_grain) noexcept;
+
+  /** @brief Returns the maximum number of threads taking part in an
+   *         operation, including the calling one. */
+  std::size_t threads() const noexcept;
+
+  /** @brief Returns the minimum number of elements in a chunk. */
+  std::size_t grain() const noexcept;
+
+  /** @brief Calls work(first, last) for every chunk of [0, count), and undo
+   *         (first, last) for the completed ones if any of them throws.
+   *         Never throws if work can't. */
+  template <class Work, class Undo>
+  void for_each_chunk(std::size_t count, Work work, Undo undo) const
+      noexcept(noexcept(work(std::size_t{}, std::size_t{})));
+
+private:
+  std::size_t threads_;
+  std::size_t grain_;
+
+  /** @brief Returns the first ordinal of chunk index out of chunks. */
+  static std::size_t chunk_start(std::size_t count, std::size_t chunks,
+                                 std::size_t index) noexcept;
+};
+
+template <> struct is_execution_policy<ekuparallel_policy> : std::true_type {};
+
+constexpr std::size_t ekuparallel_policy::default_grain;
+
+inline ekuparallel_policy::ekuparallel_policy(std::size_t threads,
+                                              std::size_t grain) noexcept
+    : threads_{threads ? threads : std::thread::hardware_concurrency()},
+      grain_{grain ? grain : 1} {
+  /* hardware_concurrency() returns zero when it can't tell */
+  threads_ = std::max<std::size_t>(threads_, 1);
+}
+
+inline std::size_t ekuparallel_policy::threads() const noexcept {
+  return threads_;
+}
+
+inline std::size_t ekuparallel_policy::grain() const noexcept {
+  return grain_;
+}
+
+template <class Work, class Undo>
+void ekuparallel_policy::for_each_chunk(std::size_t count, Work work,
+                                        Undo undo) const
+    noexcept(noexcept(work(std::size_t{}, std::size_t{}))) {
+  const auto chunks = std::min(threads_, count / grain_);
+  if (chunks < 2) {
+    work(0, count);
+    return;
+  }
+
+  std::unique_ptr<std::exception_ptr[]> errors;
+  std::vector<std::thread> workers;
+  try {
+    errors.reset(new std::exception_ptr[chunks]);
+    workers.reserve(chunks - 1);
+  } catch (...) {
+    /* no room for the bookkeeping, do it all in this thread */
+    work(0, count);
+    return;
+  }
+
+  auto run = [&](std::size_t index) {
+    try {
+      work(chunk_start(count, chunks, index),
+           chunk_start(count, chunks, index + 1));
+    } catch (...) {
+      errors[index] = std::current_exception();
+    }
+  };
+
+  std::size_t started = 1;
+  for (; started < chunks; ++started) {
+    try {
+      workers.emplace_back(run, started);
+    } catch (...) {
+      break;
+    }
+  }
+  /* the chunks that didn't get a thread of their own run here */
+  run(0);
+  for (auto index = started; index < chunks; ++index) {
+    run(index);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  std::exception_ptr failure;
+  for (std::size_t index = 0; index < chunks; ++index) {
+    if (errors[index] && !failure) {
+      failure = errors[index];
+    }
+  }
+  if (failure) {
+    for (std::size_t index = 0; index < chunks; ++index) {
+      if (!errors[index]) {
+        undo(chunk_start(count, chunks, index),
+             chunk_start(count, chunks, index + 1));
+      }
+    }
+    std::rethrow_exception(failure);
+  }
+}
+
+inline std::size_t ekuparallel_policy::chunk_start(std::size_t count,
+                                                   std::size_t chunks,
+                                                   std::size_t index) noexcept {
+  /* the first count % chunks chunks take one element more than the rest */
+  return index * (count / chunks) + std::min(index, count % chunks);
+}
+
+}; // namespace ekustd
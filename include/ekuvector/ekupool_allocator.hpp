@@ -0,0 +1,208 @@
+/**
+ * ekupool_allocator, size-class pool allocator.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace ekustd {
+
+/** @brief Pool of fixed size blocks, grouped in power of two size classes.
+ *
+ * Requests of up to max_block_size bytes are rounded up to the next size class
+ * and served from a free list, which gets refilled by carving a slab obtained
+ * from the global operator new. Released blocks go back to the free list of
+ * their size class, ready to be reused by the next request of the same size,
+ * such as a container growing while another one shrinks. Larger requests are
+ * forwarded to the global operator new. Slabs are only returned to the heap by
+ * release() or by the destructor. */
+class ekupool {
+public:
+  static constexpr std::size_t min_block_size = 16;
+  static constexpr std::size_t max_block_size = 64 * 1024;
+
+  /** @brief Constructs an empty pool. Each slab holds enough blocks of its size
+   *         class to take slab_size bytes, or at least one block. */
+  explicit ekupool(std::size_t slab_size = 64 * 1024) noexcept
+      : slab_size_{slab_size}, slabs_{nullptr}, slab_count_{0},
+        free_lists_{} {}
+
+  ekupool(const ekupool &) = delete;
+  ekupool &operator=(const ekupool &) = delete;
+
+  /** @brief Destructor. Returns every slab to the heap. */
+  ~ekupool() { release(); }
+
+  /** @brief Returns bytes of storage, aligned to a fundamental alignment
+   *         boundary. */
+  void *allocate(std::size_t bytes) {
+    if (bytes > max_block_size) {
+      return ::operator new(bytes);
+    }
+    const auto index = size_class(bytes);
+    if (!free_lists_[index]) {
+      add_slab(index);
+    }
+    auto block = free_lists_[index];
+    free_lists_[index] = block->next;
+    return block;
+  }
+
+  /** @brief Returns a block obtained from allocate() with the same
+   *         size to the pool. */
+  void deallocate(void *block, std::size_t bytes) noexcept {
+    if (bytes > max_block_size) {
+      ::operator delete(block);
+      return;
+    }
+    const auto index = size_class(bytes);
+    auto node = static_cast<free_block *>(block);
+    node->next = free_lists_[index];
+    free_lists_[index] = node;
+  }
+
+  /** @brief Returns every slab to the heap, invalidating all the blocks handed
+   *         out by the pool that were not larger than max_block_size. */
+  void release() noexcept {
+    while (slabs_) {
+      auto next = slabs_->next;
+      ::operator delete(static_cast<void *>(slabs_));
+      slabs_ = next;
+    }
+    slab_count_ = 0;
+    for (auto &list : free_lists_) {
+      list = nullptr;
+    }
+  }
+
+  /** @brief Returns the number of slabs currently taken from the heap. */
+  std::size_t slab_count() const noexcept { return slab_count_; }
+
+private:
+  struct free_block {
+    free_block *next;
+  };
+
+  struct slab_header {
+    slab_header *next;
+  };
+
+  /* 16, 32, 64, ... max_block_size */
+  static constexpr std::size_t class_count = 13;
+  static_assert((min_block_size << (class_count - 1)) == max_block_size,
+                "size classes must cover up to max_block_size");
+
+  /* slab payloads start at a fundamental alignment boundary, which is kept by
+     every block since block sizes are multiples of it */
+  static_assert(min_block_size % alignof(std::max_align_t) == 0,
+                "the smallest block must keep fundamental alignment");
+  static constexpr std::size_t header_size =
+      ((sizeof(slab_header) + alignof(std::max_align_t) - 1) /
+       alignof(std::max_align_t)) *
+      alignof(std::max_align_t);
+
+  std::size_t slab_size_;
+  slab_header *slabs_;
+  std::size_t slab_count_;
+  free_block *free_lists_[class_count];
+
+  static std::size_t size_class(std::size_t bytes) noexcept {
+    std::size_t index = 0;
+    while ((min_block_size << index) < bytes) {
+      ++index;
+    }
+    return index;
+  }
+
+  void add_slab(std::size_t index) {
+    const auto block_size = min_block_size << index;
+    const auto blocks = (slab_size_ > block_size) ? slab_size_ / block_size : 1;
+    auto raw = static_cast<char *>(
+        ::operator new(header_size + blocks * block_size));
+    auto header = reinterpret_cast<slab_header *>(raw);
+    header->next = slabs_;
+    slabs_ = header;
+    ++slab_count_;
+
+    /* thread the new blocks into the free list, keeping them in address
+       order */
+    auto payload = raw + header_size;
+    for (std::size_t block = blocks; block > 0; --block) {
+      auto node = reinterpret_cast<free_block *>(payload +
+                                                 (block - 1) * block_size);
+      node->next = free_lists_[index];
+      free_lists_[index] = node;
+    }
+  }
+};
+
+/** @brief Allocator that takes its memory from an ekupool.
+ *
+ * Copies refer to the same pool, and two allocators compare equal if they do.
+ * The allocator does not propagate on container copy, move or swap, so each
+ * container stays bound to the pool it was created with. Moving between
+ * containers on the same pool hands the storage over in O(1). Moves across
+ * pools fall back to element-wise moves. */
+template <class Type> class ekupool_allocator {
+  static_assert(alignof(Type) <= alignof(std::max_align_t),
+                "over-aligned types are not supported by ekupool");
+
+public:
+  using value_type = Type;
+  using pointer = Type *;
+  using const_pointer = const Type *;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+  template <class Other> struct rebind {
+    using other = ekupool_allocator<Other>;
+  };
+
+  /** @brief Constructs an allocator that takes memory from pool. */
+  ekupool_allocator(ekupool &pool) noexcept : pool_{&pool} {}
+
+  template <class Other>
+  ekupool_allocator(const ekupool_allocator<Other> &other) noexcept
+      : pool_{other.pool_} {}
+
+  Type *allocate(std::size_t n) {
+    return static_cast<Type *>(pool_->allocate(n * sizeof(Type)));
+  }
+
+  void deallocate(Type *p, std::size_t n) noexcept {
+    pool_->deallocate(static_cast<void *>(p), n * sizeof(Type));
+  }
+
+  /** @brief Returns the pool this allocator takes memory from. */
+  ekupool &pool() const noexcept { return *pool_; }
+
+private:
+  template <class Other> friend class ekupool_allocator;
+
+  ekupool *pool_;
+};
+
+template <class Type, class Other>
+bool operator==(const ekupool_allocator<Type> &lhs,
+                const ekupool_allocator<Other> &rhs) noexcept {
+  return &lhs.pool() == &rhs.pool();
+}
+
+template <class Type, class Other>
+bool operator!=(const ekupool_allocator<Type> &lhs,
+                const ekupool_allocator<Other> &rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}; // namespace ekustd
@@ -0,0 +1,148 @@
+/**
+ * Binary serialization of ekuvectors of trivially copyable types.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+// POSIX
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/*
+ * The serialized form of a vector is a 64 bits header holding the number of
+ * bytes of elements that follow, and then the bytes of the elements as they
+ * are in memory. Both use the byte order of the host, and elements are not
+ * converted in any way, so it's meant for exchanging data between processes
+ * built alike.
+ * */
+
+namespace detail {
+
+/* deserialize() reads the elements in chunks of this many bytes at most, so
+   that the storage grows along with the data actually received instead of
+   trusting the header upfront */
+constexpr std::size_t deserialize_chunk_bytes = std::size_t{1} << 20;
+
+/* writes the whole of both buffers, resuming after partial writes */
+inline void write_all(int fd, iovec *chunks, int count) {
+  while (count > 0) {
+    const auto written = ::writev(fd, chunks, count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(),
+                              "can't write the vector");
+    }
+    auto left = static_cast<std::size_t>(written);
+    while (count > 0 && left >= chunks->iov_len) {
+      left -= chunks->iov_len;
+      ++chunks;
+      --count;
+    }
+    if (count > 0) {
+      chunks->iov_base = static_cast<char *>(chunks->iov_base) + left;
+      chunks->iov_len -= left;
+    }
+  }
+}
+
+/* fills the whole buffer, resuming after partial reads */
+inline void read_all(int fd, void *buffer, std::size_t bytes) {
+  auto cursor = static_cast<char *>(buffer);
+  while (bytes > 0) {
+    const auto got = ::read(fd, cursor, bytes);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(),
+                              "can't read the vector");
+    }
+    if (got == 0) {
+      throw std::runtime_error("the serialized vector is truncated");
+    }
+    cursor += got;
+    bytes -= static_cast<std::size_t>(got);
+  }
+}
+
+} // namespace detail
+
+/** @brief Returns the number of bytes taken by the serialized form of
+ *         vector. */
+template <class Type, class Alloc, class Growth, class Stats>
+std::size_t
+serialized_size(const ekuvector<Type, Alloc, Growth, Stats> &vector) {
+  return sizeof(std::uint64_t) + vector.size() * sizeof(Type);
+}
+
+/** @brief Writes vector to the file descriptor fd, header and elements in a
+ *         single writev() unless it writes them partially.
+ *
+ * Throws std::system_error if writing fails. */
+template <class Type, class Alloc, class Growth, class Stats>
+void serialize(int fd, const ekuvector<Type, Alloc, Growth, Stats> &vector) {
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "only trivially copyable types can be serialized");
+  std::uint64_t header = vector.size() * sizeof(Type);
+  iovec chunks[2];
+  chunks[0].iov_base = &header;
+  chunks[0].iov_len = sizeof(header);
+  chunks[1].iov_base = const_cast<Type *>(vector.data());
+  chunks[1].iov_len = static_cast<std::size_t>(header);
+  detail::write_all(fd, chunks, header ? 2 : 1);
+}
+
+/** @brief Replaces the contents of vector with the ones read from the file
+ *         descriptor fd, reading the elements straight into its storage.
+ *
+ * The header is not trusted: the storage grows in chunks as the elements
+ * arrive, to at most twice what has been read so far, so a header that
+ * claims more data than follows can't force a huge allocation.
+ *
+ * Throws std::system_error if reading fails, and std::runtime_error if the
+ * data ends early or doesn't hold whole elements. In those cases the contents
+ * of vector are unspecified. */
+template <class Type, class Alloc, class Growth, class Stats>
+void deserialize(int fd, ekuvector<Type, Alloc, Growth, Stats> &vector) {
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "only trivially copyable types can be deserialized");
+  std::uint64_t header = 0;
+  detail::read_all(fd, &header, sizeof(header));
+  if ((header % sizeof(Type)) != 0 ||
+      header / sizeof(Type) > vector.max_size()) {
+    throw std::runtime_error("the serialized vector is malformed");
+  }
+  const auto count = static_cast<std::size_t>(header / sizeof(Type));
+  const auto chunk = std::max<std::size_t>(
+      1, detail::deserialize_chunk_bytes / sizeof(Type));
+  vector.clear();
+  std::size_t done = 0;
+  while (done < count) {
+    const auto step = std::min(chunk, count - done);
+    if (vector.capacity() < done + step) {
+      vector.reserve(std::min(count, 2 * (done + step)));
+    }
+    vector.resize_default_init(done + step);
+    detail::read_all(fd, vector.data() + done, step * sizeof(Type));
+    done += step;
+  }
+}
+
+}; // namespace ekustd
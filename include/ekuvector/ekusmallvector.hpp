@@ -0,0 +1,1263 @@
+/**
+ * ekusmallvector, ekuvector with inline storage for small sizes.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+/** @brief Vector with room for N elements inside the object itself.
+ *
+ * It shares the interface and the member layout of ekuvector, but data_ points
+ * to an inline buffer while the contents fit in it. The Allocator is only used
+ * once the container grows past N elements, and shrink_to_fit() moves the
+ * contents back into the inline buffer when they fit again.
+ *
+ * Moving or swapping a container whose contents live on the heap just hands
+ * over the memory block. Inline contents can't be handed over, so they are
+ * relocated element by element (at most N of them). */
+template <class Type, std::size_t N, class Allocator = std::allocator<Type>,
+          class Growth = geometric_growth<>>
+class ekusmallvector {
+  static_assert(N > 0, "use ekuvector if no inline storage is needed");
+  /* data_ may point to the inline buffer, which a fancy pointer can't */
+  static_assert(
+      std::is_same<typename std::allocator_traits<Allocator>::pointer,
+                   Type *>::value,
+      "ekusmallvector requires an allocator with raw pointers");
+
+public:
+  using type = Type;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = Type;
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
+
+  using pointer = Type *;
+  using const_pointer = const Type *;
+
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /** @brief Number of elements that fit in the inline buffer. */
+  static constexpr size_type inline_capacity = N;
+
+  /** @brief Default constructor. Constructs an empty container with a
+   *         default-constructed allocator_. */
+  ekusmallvector();
+
+  /** @brief Constructs an empty container with the given allocator alloc. */
+  explicit ekusmallvector(const Allocator &alloc);
+
+  /** @brief Constructs the container with count default-inserted instances of
+   *         Type. No copies are made. */
+  ekusmallvector(size_type count);
+
+  /** @brief Constructs the container with count copies of elements with value
+   *         value. */
+  ekusmallvector(size_type count, const Type &value,
+                 const Allocator &alloc = Allocator());
+
+  /** @brief  Constructs the container with the contents of the range [first,
+   *          last).
+   *
+   * This overload only participates in overload resolution if InputIt satisfies
+   * LegacyInputIterator, to avoid ambiguity with the overload (3).
+   * */
+  template <class InputIt>
+  ekusmallvector(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
+      const Allocator &alloc = Allocator());
+
+  /** @brief Copy constructor. Constructs the container with the copy of the
+   *         contents of other. */
+  ekusmallvector(const ekusmallvector &other);
+  ekusmallvector(const ekusmallvector &other, const Allocator &alloc);
+
+  /** @brief Move constructor.
+   *
+   * Heap contents are handed over in O(1), inline contents are relocated into
+   * the inline buffer of the new container. After the move, other is
+   * guaranteed to be empty(). Never throws if moving an element can't throw.
+   * */
+  ekusmallvector(ekusmallvector &&other) noexcept(
+      std::is_nothrow_move_constructible<Type>::value);
+
+  /** @brief Allocator-extended move constructor.
+   *
+   * If alloc != other.get_allocator(), this results in an element-wise move.
+   * (in that case, other is not guaranteed to be empty after the move) */
+  ekusmallvector(ekusmallvector &&other, const Allocator &alloc);
+
+  /** @brief Constructs the container with the contents of the initializer list
+   *         init.  */
+  ekusmallvector(std::initializer_list<Type> init,
+                 const Allocator &alloc = Allocator());
+
+  /** @brief Destructor. */
+  ~ekusmallvector();
+
+  /** @brief Copy assignment operator. */
+  ekusmallvector &operator=(const ekusmallvector &other);
+
+  /** @brief Move assignment operator.
+   *
+   * If
+   * std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+   * is true or the allocators compare equal, the contents of other are taken
+   * over as done by the move constructor. Otherwise each element is moved
+   * individually. */
+  ekusmallvector &operator=(ekusmallvector &&other) noexcept(
+      std::is_nothrow_move_constructible<Type>::value &&
+      detail::nothrow_move_assignment<Allocator>::value);
+
+  /** @brief Replaces the contents with those identified by initializer list
+   *         ilist. */
+  ekusmallvector &operator=(std::initializer_list<Type> ilist);
+
+  /** @brief Replaces the contents with count copies of value value */
+  void assign(size_type count, const Type &value);
+
+  /** @brief Replaces the contents with copies of those in the range [first,
+   *         last). */
+  template <class InputIt>
+  void assign(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Replaces the contents with the elements from the initializer list
+   *         ilist. */
+  void assign(std::initializer_list<Type> ilist);
+
+  /** @brief Returns the allocator associated with the container. */
+  allocator_type get_allocator() const;
+
+  /** @brief Returns a reference to the element at specified location pos, with
+   *         bounds checking. */
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  /** @brief Returns a reference to the element at specified location pos. No
+   *         bounds checking is performed.  */
+  reference operator[](size_type pos);
+  const_reference operator[](size_type pos) const;
+
+  /** @brief Returns a reference to the first element in the container. */
+  reference front();
+  const_reference front() const;
+
+  /** @brief Returns reference to the last element in the container. */
+  reference back();
+  const_reference back() const;
+
+  /** @brief Returns pointer to the underlying array serving as element storage,
+   *         which is the inline buffer while the contents fit in it. */
+  Type *data() noexcept;
+  const Type *data() const noexcept;
+
+  /** @brief Iterators to the beginning of the container. */
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  /** @brief Iterators to the end of the container. */
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  /** @brief Reverse iterators to the beginning of the reversed container. */
+  reverse_iterator rbegin() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator crbegin() const noexcept;
+
+  /** @brief Reverse iterators to the end of the reversed container. */
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rend() const noexcept;
+  const_reverse_iterator crend() const noexcept;
+
+  /** @brief Checks if the container has no elements. */
+  bool empty() const noexcept;
+
+  /** @brief Returns the number of elements in the container. */
+  size_type size() const noexcept;
+
+  /** @brief Returns the maximum number of elements the container is able to
+   * hold. */
+  size_type max_size() const noexcept;
+
+  /** @brief Increase the capacity to a value that's greater or equal to
+   *         new_cap. Capacities past N move the contents to the heap. */
+  void reserve(size_type new_cap);
+
+  /** @brief Returns the number of elements that the container has currently
+   * allocated space for. This is never less than N. */
+  size_type capacity() const noexcept;
+
+  /** @brief Checks whether the contents live in the inline buffer. */
+  bool is_inline() const noexcept;
+
+  /** @brief Requests the removal of unused capacity.
+   *
+   * Contents that fit in the inline buffer are moved back into it, and the heap
+   * block is released. */
+  void shrink_to_fit();
+
+  /** @brief Erases all elements from the container. Leaves the capacity()
+   *         unchanged. */
+  void clear() noexcept;
+
+  /** @brief Inserts value before pos */
+  iterator insert(const_iterator pos, const Type &value);
+  iterator insert(const_iterator pos, Type &&value);
+
+  /** @brief Inserts count copies of the value before pos */
+  iterator insert(const_iterator pos, size_type count, const Type &value);
+
+  /** @brief inserts elements from range [first, last) before pos.
+   *
+   * The behavior is undefined if first and last are iterators into *this. */
+  template <class InputIt>
+  iterator insert(
+      const_iterator pos, InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Inserts elements from initializer list ilist before pos. */
+  iterator insert(const_iterator pos, std::initializer_list<Type> ilist);
+
+  /** @brief Inserts a new element constructed from args directly before
+   *         pos. */
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&... args);
+
+  /** @brief Removes the element at pos. */
+  iterator erase(const_iterator pos);
+
+  /** @brief Removes the elements in the range [first, last). */
+  iterator erase(const_iterator first, const_iterator last);
+
+  /** @brief Appends the given element value to the end of the container. */
+  void push_back(const Type &value);
+  void push_back(Type &&value);
+
+  /** @brief Appends a new element constructed from args to the end of the
+   *         container. */
+  template <class... Args> void emplace_back(Args &&... args);
+
+  /** @brief Removes the last element of the container. */
+  void pop_back();
+
+  /** @brief Resizes the container to contain count elements, appending
+   *         default-inserted elements if needed. */
+  void resize(size_type count);
+
+  /** @brief Resizes the container to contain count elements, appending copies
+   *         of value if needed. */
+  void resize(size_type count, const value_type &value);
+
+  /** @brief Resizes the container to contain count elements, leaving the
+   *         appended elements default-initialized. */
+  void resize_default_init(size_type count);
+
+  /** @brief Exchanges the contents of the container with those of other.
+   *
+   * Heap contents are exchanged without touching the elements, inline
+   * contents are relocated between the inline buffers. Never throws if moving
+   * elements can't throw. */
+  void swap(ekusmallvector &other) noexcept(
+      std::is_nothrow_move_constructible<Type>::value &&
+      std::is_nothrow_move_assignable<Type>::value);
+
+private:
+  using storage_type =
+      typename std::aligned_storage<sizeof(Type), alignof(Type)>::type;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  Allocator allocator_;
+  size_t capacity_;
+  size_t size_;
+  pointer data_;
+  storage_type inline_storage_[N];
+
+  /** @brief Returns a pointer to the first slot of the inline buffer. */
+  pointer inline_data() noexcept;
+
+  /** @brief Makes sure there's room for at least new_cap elements, growing the
+   *         storage as dictated by the growth policy. */
+  void preallocate_capacity(size_type new_cap);
+
+  /** @brief Moves the contents to a block with room for exactly new_cap
+   *         elements, or to the inline buffer if new_cap is not greater than
+   *         N. new_cap must not be less than size(). */
+  void reallocate(size_type new_cap);
+
+  /** @brief Moves the contents to a new, larger block, constructing a new
+   *         element from args at ordinal inside the new block along the way.
+   * */
+  template <class... Args>
+  void realloc_emplace(size_type ordinal, Args &&... args);
+
+  /** @brief Moves the contents to a new block with room for new_cap
+   *         elements, filling count copies of value in at ordinal inside the
+   *         new block along the way. */
+  void realloc_fill(size_type new_cap, size_type ordinal, size_type count,
+                    const Type &value);
+
+  /** @brief Replaces the contents with count elements read from first,
+   *         reusing the live elements through copy-assignment. */
+  template <class ForwardIt> void assign_n(ForwardIt first, size_type count);
+
+  /** @brief Replaces the contents with the range [first, last).
+   *
+   * As in ekuvector, single-pass ranges are assigned element by element, and
+   * multi-pass ranges are measured upfront so that they can be copied in
+   * bulk. */
+  template <class InputIt>
+  void assign_range(InputIt first, InputIt last, std::input_iterator_tag);
+  template <class ForwardIt>
+  void assign_range(ForwardIt first, ForwardIt last,
+                    std::forward_iterator_tag);
+
+  /** @brief Inserts the range [first, last) before the element at ordinal.
+   *
+   * As in ekuvector, single-pass ranges are appended to the end and then
+   * rotated into place, and multi-pass ranges are measured upfront. Ranges
+   * over the contents of the container are copied aside before the tail gets
+   * shifted over them. */
+  template <class InputIt>
+  void insert_range(size_type ordinal, InputIt first, InputIt last,
+                    std::input_iterator_tag);
+  template <class ForwardIt>
+  void insert_range(size_type ordinal, ForwardIt first, ForwardIt last,
+                    std::forward_iterator_tag);
+
+  /** @brief Releases the heap block, if any, and points data_ back to the
+   *         inline buffer. The container must be empty. */
+  void release_storage() noexcept;
+
+  /** @brief Takes over the contents of other, leaving it empty. This container
+   *         must be empty and using its inline buffer. */
+  void steal(ekusmallvector &other);
+};
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+constexpr std::size_t
+    ekusmallvector<Type, N, Allocator, Growth>::inline_capacity;
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector()
+    : ekusmallvector(Allocator()) {}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    const Allocator &alloc)
+    : allocator_{alloc}, capacity_{N}, size_{0}, data_{inline_data()} {}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(size_type count)
+    : ekusmallvector() {
+  resize(count);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    size_type count, const Type &value, const Allocator &alloc)
+    : ekusmallvector(alloc) {
+  resize(count, value);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class InputIt>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
+    const Allocator &alloc)
+    : ekusmallvector(alloc) {
+  assign_range(first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    const ekusmallvector &other)
+    : ekusmallvector(other, std::allocator_traits<allocator_type>::
+                                select_on_container_copy_construction(
+                                    other.get_allocator())) {}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    const ekusmallvector &other, const Allocator &alloc)
+    : ekusmallvector(alloc) {
+  assign_n(other.data_, other.size_);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    ekusmallvector &&other) noexcept(
+    std::is_nothrow_move_constructible<Type>::value)
+    : ekusmallvector(other.allocator_) {
+  steal(other);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    ekusmallvector &&other, const Allocator &alloc)
+    : ekusmallvector(alloc) {
+  if (allocator_ == other.allocator_) {
+    steal(other);
+  } else {
+    reserve(other.size());
+    for (auto &item : other) {
+      emplace_back(std::move(item));
+    }
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::ekusmallvector(
+    std::initializer_list<Type> init, const Allocator &alloc)
+    : ekusmallvector(init.begin(), init.end(), alloc) {}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth>::~ekusmallvector() {
+  clear();
+  release_storage();
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth> &
+ekusmallvector<Type, N, Allocator, Growth>::
+operator=(const ekusmallvector &other) {
+  if (this != &other) {
+    if (std::allocator_traits<
+            allocator_type>::propagate_on_container_copy_assignment::value) {
+      /* memory from the old allocator must be returned to it */
+      if (allocator_ != other.allocator_) {
+        clear();
+        release_storage();
+      }
+      allocator_ = other.allocator_;
+    }
+    assign_n(other.data_, other.size_);
+  }
+  return *this;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth> &
+ekusmallvector<Type, N, Allocator, Growth>::operator=(
+    ekusmallvector &&other) noexcept(std::is_nothrow_move_constructible<
+                                         Type>::value &&
+                                     detail::nothrow_move_assignment<
+                                         Allocator>::value) {
+  if (this == &other) {
+    return *this;
+  }
+  clear();
+  using propagate =
+      typename alloc_traits::propagate_on_container_move_assignment;
+  if (propagate::value || (allocator_ == other.allocator_)) {
+    /* the heap block of other can be taken over */
+    release_storage();
+    detail::propagate_allocator(allocator_, std::move(other.allocator_),
+                                propagate{});
+    steal(other);
+  } else {
+    reserve(other.size());
+    for (auto &item : other) {
+      emplace_back(std::move(item));
+    }
+  }
+  return *this;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+ekusmallvector<Type, N, Allocator, Growth> &
+ekusmallvector<Type, N, Allocator, Growth>::
+operator=(std::initializer_list<Type> ilist) {
+  assign(ilist.begin(), ilist.end());
+  return *this;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::assign(size_type count,
+                                                        const Type &value) {
+  clear();
+  resize(count, value);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class InputIt>
+void ekusmallvector<Type, N, Allocator, Growth>::assign(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  assign_range(first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::assign(
+    std::initializer_list<Type> ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::allocator_type
+ekusmallvector<Type, N, Allocator, Growth>::get_allocator() const {
+  return allocator_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::reference
+ekusmallvector<Type, N, Allocator, Growth>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("vector index out of range");
+  }
+  return *(data_ + pos);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reference
+ekusmallvector<Type, N, Allocator, Growth>::at(size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("vector index out of range");
+  }
+  return *(data_ + pos);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::reference
+    ekusmallvector<Type, N, Allocator, Growth>::operator[](size_type pos) {
+  return *(data_ + pos);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reference
+    ekusmallvector<Type, N, Allocator, Growth>::
+    operator[](size_type pos) const {
+  return *(data_ + pos);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::reference
+ekusmallvector<Type, N, Allocator, Growth>::front() {
+  return *data_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reference
+ekusmallvector<Type, N, Allocator, Growth>::front() const {
+  return *data_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::reference
+ekusmallvector<Type, N, Allocator, Growth>::back() {
+  return *(data_ + size_ - 1);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reference
+ekusmallvector<Type, N, Allocator, Growth>::back() const {
+  return *(data_ + size_ - 1);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+Type *ekusmallvector<Type, N, Allocator, Growth>::data() noexcept {
+  return data_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+const Type *ekusmallvector<Type, N, Allocator, Growth>::data() const noexcept {
+  return data_;
+}
+
+/* *** */
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::begin() noexcept {
+  return data_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_iterator
+ekusmallvector<Type, N, Allocator, Growth>::begin() const noexcept {
+  return data_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_iterator
+ekusmallvector<Type, N, Allocator, Growth>::cbegin() const noexcept {
+  return data_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::end() noexcept {
+  return data_ + size_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_iterator
+ekusmallvector<Type, N, Allocator, Growth>::end() const noexcept {
+  return data_ + size_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_iterator
+ekusmallvector<Type, N, Allocator, Growth>::cend() const noexcept {
+  return data_ + size_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::reverse_iterator
+ekusmallvector<Type, N, Allocator, Growth>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reverse_iterator
+ekusmallvector<Type, N, Allocator, Growth>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reverse_iterator
+ekusmallvector<Type, N, Allocator, Growth>::crbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::reverse_iterator
+ekusmallvector<Type, N, Allocator, Growth>::rend() noexcept {
+  return reverse_iterator{begin()};
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reverse_iterator
+ekusmallvector<Type, N, Allocator, Growth>::rend() const noexcept {
+  return const_reverse_iterator{begin()};
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::const_reverse_iterator
+ekusmallvector<Type, N, Allocator, Growth>::crend() const noexcept {
+  return const_reverse_iterator{begin()};
+}
+
+/* *** */
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+bool ekusmallvector<Type, N, Allocator, Growth>::empty() const noexcept {
+  return (size_ == 0);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::size_type
+ekusmallvector<Type, N, Allocator, Growth>::size() const noexcept {
+  return size_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::size_type
+ekusmallvector<Type, N, Allocator, Growth>::max_size() const noexcept {
+  return std::min<size_type>(alloc_traits::max_size(allocator_),
+                             std::numeric_limits<difference_type>::max());
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::reserve(size_type new_cap) {
+  if (new_cap > capacity_) {
+    reallocate(Growth::fit_capacity(new_cap, sizeof(Type)));
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::size_type
+ekusmallvector<Type, N, Allocator, Growth>::capacity() const noexcept {
+  return capacity_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+bool ekusmallvector<Type, N, Allocator, Growth>::is_inline() const noexcept {
+  return data_ == reinterpret_cast<const_pointer>(inline_storage_);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::shrink_to_fit() {
+  if (is_inline()) {
+    return;
+  }
+  const auto new_capacity = (size_ <= N)
+                                ? N
+                                : Growth::fit_capacity(size_, sizeof(Type));
+  if (new_capacity < capacity_) {
+    reallocate(new_capacity);
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::clear() noexcept {
+  detail::destroy_range(allocator_, data_, data_ + size_);
+  size_ = 0;
+}
+
+/* *** */
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::insert(const_iterator pos,
+                                                   const Type &value) {
+  const auto pos_ordinal = static_cast<size_type>(pos - cbegin());
+  if (size_ == capacity_) {
+    realloc_emplace(pos_ordinal, value);
+  } else if (pos_ordinal == size_) {
+    detail::construct(allocator_, end(), value);
+    ++size_;
+  } else {
+    /* value may be an element of the tail that's about to be shifted */
+    auto new_pos = begin() + pos_ordinal;
+    auto value_ptr = std::addressof(value);
+    if ((new_pos <= value_ptr) && (value_ptr < end())) {
+      ++value_ptr;
+    }
+    detail::shift_insert(allocator_, new_pos, end(), *value_ptr);
+    ++size_;
+  }
+  return begin() + pos_ordinal;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::insert(const_iterator pos,
+                                                   Type &&value) {
+  return emplace(pos, std::move(value));
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::insert(const_iterator pos,
+                                                   size_type count,
+                                                   const Type &value) {
+  const auto pos_ordinal = static_cast<size_type>(pos - cbegin());
+  if (count > 0) {
+    /* value may be an element that's about to be moved around */
+    const Type value_copy(value);
+    const auto tail_size = size_ - pos_ordinal;
+    const auto grows = size_ + count > capacity_;
+    if (grows ||
+        (tail_size && !detail::gap_relocation_tag<Allocator, Type>::value)) {
+      /* as in ekuvector, a tail that can't be shifted safely goes to a new
+         block even if there's room for the copies */
+      realloc_fill(grows ? Growth::next_capacity(capacity_, size_ + count,
+                                                 sizeof(Type))
+                         : capacity_,
+                   pos_ordinal, count, value_copy);
+      return begin() + pos_ordinal;
+    }
+    auto new_pos = begin() + pos_ordinal;
+    detail::relocate_backward(allocator_, new_pos + count, new_pos,
+                              tail_size);
+    try {
+      detail::fill_construct_n(allocator_, new_pos, count, value_copy);
+    } catch (...) {
+      detail::relocate_forward(allocator_, new_pos, new_pos + count,
+                               tail_size);
+      throw;
+    }
+    size_ += count;
+  }
+  return begin() + pos_ordinal;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class InputIt>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::insert(
+    const_iterator pos, InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  const auto pos_ordinal = static_cast<size_type>(pos - cbegin());
+  insert_range(pos_ordinal, first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
+  return begin() + pos_ordinal;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::insert(
+    const_iterator pos, std::initializer_list<Type> ilist) {
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class... Args>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::emplace(const_iterator pos,
+                                                    Args &&... args) {
+  const auto pos_ordinal = static_cast<size_type>(pos - cbegin());
+  if (size_ == capacity_) {
+    realloc_emplace(pos_ordinal, std::forward<Args>(args)...);
+  } else if (pos_ordinal == size_) {
+    detail::construct(allocator_, end(), std::forward<Args>(args)...);
+    ++size_;
+  } else {
+    /* args may refer to an element of the tail that's about to be shifted,
+       so the new element is built aside before making room for it */
+    Type value(std::forward<Args>(args)...);
+    detail::shift_insert(allocator_, begin() + pos_ordinal, end(),
+                         std::move(value));
+    ++size_;
+  }
+  return begin() + pos_ordinal;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::erase(const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::iterator
+ekusmallvector<Type, N, Allocator, Growth>::erase(const_iterator first,
+                                                  const_iterator last) {
+  auto head = begin() + (first - cbegin());
+  auto tail = begin() + (last - cbegin());
+  auto new_end = detail::erase_range(allocator_, head, tail, end());
+  size_ = static_cast<size_type>(new_end - begin());
+  return head;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::push_back(const Type &value) {
+  emplace_back(value);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::push_back(Type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class... Args>
+void ekusmallvector<Type, N, Allocator, Growth>::emplace_back(
+    Args &&... args) {
+  if (size_ == capacity_) {
+    realloc_emplace(size_, std::forward<Args>(args)...);
+  } else {
+    detail::construct(allocator_, end(), std::forward<Args>(args)...);
+    ++size_;
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::pop_back() {
+  if (size_) {
+    --size_;
+    detail::destroy(allocator_, data_ + size_);
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::resize(size_type count) {
+  if (count > size_) {
+    preallocate_capacity(count);
+    detail::value_construct_n(allocator_, data_ + size_, count - size_);
+  } else {
+    detail::destroy_range(allocator_, data_ + count, data_ + size_);
+  }
+  size_ = count;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::resize(
+    size_type count, const value_type &value) {
+  if (size_ < count) {
+    insert(end(), count - size_, value);
+  }
+  if (size_ > count) {
+    detail::destroy_range(allocator_, data_ + count, data_ + size_);
+    size_ = count;
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::resize_default_init(
+    size_type count) {
+  if (count > size_) {
+    preallocate_capacity(count);
+    detail::default_construct_n(allocator_, data_ + size_, count - size_);
+  } else {
+    detail::destroy_range(allocator_, data_ + count, data_ + size_);
+  }
+  size_ = count;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::swap(
+    ekusmallvector &other) noexcept(
+    std::is_nothrow_move_constructible<Type>::value &&
+    std::is_nothrow_move_assignable<Type>::value) {
+  if (this == &other) {
+    return;
+  }
+  if (!is_inline() && !other.is_inline()) {
+    /* both contents are on the heap, just exchange the blocks */
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+  } else if (is_inline() && other.is_inline()) {
+    /* swap the common part, and relocate the surplus of the longer one */
+    auto &shorter = (size_ < other.size_) ? *this : other;
+    auto &longer = (size_ < other.size_) ? other : *this;
+    std::swap_ranges(shorter.data_, shorter.data_ + shorter.size_,
+                     longer.data_);
+    detail::relocate_forward(allocator_, shorter.data_ + shorter.size_,
+                             longer.data_ + shorter.size_,
+                             longer.size_ - shorter.size_);
+  } else {
+    /* the inline contents move into the other inline buffer, and the heap
+       block goes the opposite way */
+    auto &inline_side = is_inline() ? *this : other;
+    auto &heap_side = is_inline() ? other : *this;
+    const auto heap_data = heap_side.data_;
+    const auto heap_capacity = heap_side.capacity_;
+    detail::relocate_forward(allocator_, heap_side.inline_data(),
+                             inline_side.data_, inline_side.size_);
+    heap_side.data_ = heap_side.inline_data();
+    heap_side.capacity_ = N;
+    inline_side.data_ = heap_data;
+    inline_side.capacity_ = heap_capacity;
+  }
+  std::swap(size_, other.size_);
+  detail::swap_allocators(
+      allocator_, other.allocator_,
+      typename alloc_traits::propagate_on_container_swap{});
+}
+
+/* *** */
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+typename ekusmallvector<Type, N, Allocator, Growth>::pointer
+ekusmallvector<Type, N, Allocator, Growth>::inline_data() noexcept {
+  return reinterpret_cast<pointer>(inline_storage_);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::preallocate_capacity(
+    size_type new_cap) {
+  if (new_cap > capacity_) {
+    reallocate(Growth::next_capacity(capacity_, new_cap, sizeof(Type)));
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::reallocate(
+    size_type new_cap) {
+  const auto to_inline = (new_cap <= N);
+  auto new_data_ptr =
+      to_inline ? inline_data() : alloc_traits::allocate(allocator_, new_cap);
+  if (new_data_ptr == data_) {
+    return;
+  }
+
+  /* move the contents to the new block, and then release the old one */
+  try {
+    detail::relocate_around(allocator_, new_data_ptr, data_, size_, 0, size_);
+  } catch (...) {
+    if (!to_inline) {
+      alloc_traits::deallocate(allocator_, new_data_ptr, new_cap);
+    }
+    throw;
+  }
+  if (!is_inline()) {
+    alloc_traits::deallocate(allocator_, data_, capacity_);
+  }
+
+  data_ = new_data_ptr;
+  capacity_ = to_inline ? N : new_cap;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class... Args>
+void ekusmallvector<Type, N, Allocator, Growth>::realloc_emplace(
+    size_type ordinal, Args &&... args) {
+  const auto new_capacity =
+      Growth::next_capacity(capacity_, size_ + 1, sizeof(Type));
+  auto new_data_ptr = alloc_traits::allocate(allocator_, new_capacity);
+
+  /* args may refer to an element of this container, so the new element must
+     be built before the old ones get moved away */
+  try {
+    detail::construct(allocator_, new_data_ptr + ordinal,
+                      std::forward<Args>(args)...);
+  } catch (...) {
+    alloc_traits::deallocate(allocator_, new_data_ptr, new_capacity);
+    throw;
+  }
+
+  try {
+    detail::relocate_around(allocator_, new_data_ptr, data_, ordinal, 1,
+                            size_);
+  } catch (...) {
+    detail::destroy(allocator_, new_data_ptr + ordinal);
+    alloc_traits::deallocate(allocator_, new_data_ptr, new_capacity);
+    throw;
+  }
+  if (!is_inline()) {
+    alloc_traits::deallocate(allocator_, data_, capacity_);
+  }
+
+  data_ = new_data_ptr;
+  capacity_ = new_capacity;
+  ++size_;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class ForwardIt>
+void ekusmallvector<Type, N, Allocator, Growth>::assign_n(ForwardIt first,
+                                                          size_type count) {
+  if (count > capacity_) {
+    /* no room for the new contents, start over in a new block */
+    clear();
+    reserve(count);
+  }
+  const auto common = std::min(size_, count);
+  first = detail::copy_assign_n(first, common, data_);
+  if (count > size_) {
+    detail::copy_construct_n(allocator_, first, count - size_, data_ + size_);
+  } else {
+    detail::destroy_range(allocator_, data_ + count, data_ + size_);
+  }
+  size_ = count;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class InputIt>
+void ekusmallvector<Type, N, Allocator, Growth>::assign_range(
+    InputIt first, InputIt last, std::input_iterator_tag) {
+  /* copy-assign over the live elements while there are any */
+  size_type index = 0;
+  for (; (first != last) && (index < size_); ++first, ++index) {
+    data_[index] = *first;
+  }
+  /* then either destroy the leftovers, or append the rest of the range */
+  detail::destroy_range(allocator_, data_ + index, data_ + size_);
+  size_ = index;
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class ForwardIt>
+void ekusmallvector<Type, N, Allocator, Growth>::assign_range(
+    ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+  assign_n(first, static_cast<size_type>(std::distance(first, last)));
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::realloc_fill(
+    size_type new_cap, size_type ordinal, size_type count, const Type &value) {
+  auto new_data_ptr = alloc_traits::allocate(allocator_, new_cap);
+  try {
+    detail::fill_construct_n(allocator_, new_data_ptr + ordinal, count, value);
+  } catch (...) {
+    alloc_traits::deallocate(allocator_, new_data_ptr, new_cap);
+    throw;
+  }
+
+  try {
+    detail::relocate_around(allocator_, new_data_ptr, data_, ordinal, count,
+                            size_);
+  } catch (...) {
+    detail::destroy_range(allocator_, new_data_ptr + ordinal,
+                          new_data_ptr + ordinal + count);
+    alloc_traits::deallocate(allocator_, new_data_ptr, new_cap);
+    throw;
+  }
+  if (!is_inline()) {
+    alloc_traits::deallocate(allocator_, data_, capacity_);
+  }
+
+  data_ = new_data_ptr;
+  capacity_ = new_cap;
+  size_ += count;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class InputIt>
+void ekusmallvector<Type, N, Allocator, Growth>::insert_range(
+    size_type ordinal, InputIt first, InputIt last, std::input_iterator_tag) {
+  const auto old_size = size_;
+  try {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  } catch (...) {
+    detail::destroy_range(allocator_, data_ + old_size, data_ + size_);
+    size_ = old_size;
+    throw;
+  }
+  std::rotate(data_ + ordinal, data_ + old_size, data_ + size_);
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+template <class ForwardIt>
+void ekusmallvector<Type, N, Allocator, Growth>::insert_range(
+    size_type ordinal, ForwardIt first, ForwardIt last,
+    std::forward_iterator_tag) {
+  const auto count = static_cast<size_type>(std::distance(first, last));
+  if (count == 0) {
+    return;
+  }
+  const auto tail_size = size_ - ordinal;
+  const auto grows = size_ + count > capacity_;
+  const auto in_place =
+      !grows &&
+      (!tail_size || detail::gap_relocation_tag<Allocator, Type>::value);
+  if (in_place && detail::range_aliases(first, data_, size_)) {
+    /* the tail is about to be shifted over the range, so copy it aside */
+    ekusmallvector staged(first, last, allocator_);
+    insert_range(ordinal, std::make_move_iterator(staged.begin()),
+                 std::make_move_iterator(staged.end()),
+                 std::forward_iterator_tag{});
+    return;
+  }
+  if (!in_place) {
+    /* build the new elements in a new block, and then relocate the old ones
+       around them, so that each element gets moved only once. That's also
+       done without growing when the tail can't be shifted safely */
+    const auto new_capacity =
+        grows ? Growth::next_capacity(capacity_, size_ + count, sizeof(Type))
+              : capacity_;
+    auto new_data_ptr = alloc_traits::allocate(allocator_, new_capacity);
+    try {
+      detail::copy_construct_n(allocator_, first, count,
+                               new_data_ptr + ordinal);
+    } catch (...) {
+      alloc_traits::deallocate(allocator_, new_data_ptr, new_capacity);
+      throw;
+    }
+    try {
+      detail::relocate_around(allocator_, new_data_ptr, data_, ordinal, count,
+                              size_);
+    } catch (...) {
+      detail::destroy_range(allocator_, new_data_ptr + ordinal,
+                            new_data_ptr + ordinal + count);
+      alloc_traits::deallocate(allocator_, new_data_ptr, new_capacity);
+      throw;
+    }
+    if (!is_inline()) {
+      alloc_traits::deallocate(allocator_, data_, capacity_);
+    }
+    data_ = new_data_ptr;
+    capacity_ = new_capacity;
+  } else {
+    /* open a gap for the new elements, and close it again if the copies
+       fail */
+    auto gap = data_ + ordinal;
+    detail::relocate_backward(allocator_, gap + count, gap, tail_size);
+    try {
+      detail::copy_construct_n(allocator_, first, count, gap);
+    } catch (...) {
+      detail::relocate_forward(allocator_, gap, gap + count, tail_size);
+      throw;
+    }
+  }
+  size_ += count;
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::release_storage() noexcept {
+  if (!is_inline()) {
+    alloc_traits::deallocate(allocator_, data_, capacity_);
+    data_ = inline_data();
+    capacity_ = N;
+  }
+}
+
+template <class Type, std::size_t N, class Allocator, class Growth>
+void ekusmallvector<Type, N, Allocator, Growth>::steal(ekusmallvector &other) {
+  if (other.is_inline()) {
+    detail::relocate_forward(allocator_, data_, other.data_, other.size_);
+  } else {
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+    other.data_ = other.inline_data();
+    other.capacity_ = N;
+  }
+  size_ = other.size_;
+  other.size_ = 0;
+}
+
+/*
+ * *** NON MEMBERS ***
+ * */
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+bool operator==(const ekusmallvector<Type, N, Alloc, Growth> &lhs,
+                const ekusmallvector<Type, N, Alloc, Growth> &rhs) {
+  return detail::equal_contents(lhs.data(), lhs.size(), rhs.data(),
+                                rhs.size());
+}
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+bool operator!=(const ekusmallvector<Type, N, Alloc, Growth> &lhs,
+                const ekusmallvector<Type, N, Alloc, Growth> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+bool operator<(const ekusmallvector<Type, N, Alloc, Growth> &lhs,
+               const ekusmallvector<Type, N, Alloc, Growth> &rhs) {
+  return detail::less_contents(lhs.data(), lhs.size(), rhs.data(),
+                               rhs.size());
+}
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+bool operator<=(const ekusmallvector<Type, N, Alloc, Growth> &lhs,
+                const ekusmallvector<Type, N, Alloc, Growth> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+bool operator>(const ekusmallvector<Type, N, Alloc, Growth> &lhs,
+               const ekusmallvector<Type, N, Alloc, Growth> &rhs) {
+  return rhs < lhs;
+}
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+bool operator>=(const ekusmallvector<Type, N, Alloc, Growth> &lhs,
+                const ekusmallvector<Type, N, Alloc, Growth> &rhs) {
+  return !(lhs < rhs);
+}
+
+template <class Type, std::size_t N, class Alloc, class Growth>
+void swap(ekusmallvector<Type, N, Alloc, Growth> &lhs,
+          ekusmallvector<Type, N, Alloc, Growth> &rhs) noexcept(
+    noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+}; // namespace ekustd
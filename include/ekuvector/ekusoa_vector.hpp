@@ -0,0 +1,814 @@
+/**
+ * ekusoa_vector, structure-of-arrays container of records.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+namespace detail {
+
+/** @brief Logical and of the traits in Traits, as std::conjunction in
+ *         C++17. */
+template <class... Traits> struct conjunction : std::true_type {};
+
+template <class Trait, class... Traits>
+struct conjunction<Trait, Traits...>
+    : std::integral_constant<bool, Trait::value &&
+                                       conjunction<Traits...>::value> {};
+
+} // namespace detail
+
+/** @brief Vector of records whose fields are each stored in a contiguous
+ *         column of their own.
+ *
+ * Loops touching a few of the fields only pull those columns into the cache,
+ * and each column can be handed to vectorized code through data<I>(). All the
+ * columns live in a single memory block, one after the other, and grow along
+ * with it as decided by geometric_growth<> for rows of the combined size of
+ * the fields. Elements are constructed, relocated and destroyed with the same
+ * helpers ekuvector uses.
+ *
+ * Rows are accessed through proxies, tuples of references to the fields of a
+ * row, both from operator[] and from the iterators. Fields must be nothrow
+ * move constructible, so that growing can't fail half way through the
+ * columns. */
+template <class... Fields> class ekusoa_vector {
+  static_assert(sizeof...(Fields) > 0, "records need at least one field");
+  static_assert(detail::conjunction<std::is_nothrow_move_constructible<
+                    Fields>...>::value,
+                "fields must be nothrow move constructible");
+  static_assert(detail::conjunction<std::integral_constant<
+                    bool, alignof(Fields) <= alignof(std::max_align_t)>...>::
+                    value,
+                "over-aligned fields are not supported");
+
+  template <bool Const> class basic_iterator;
+
+public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields &...>;
+  using const_reference = std::tuple<const Fields &...>;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using growth_policy = geometric_growth<>;
+
+  /** @brief Type of the I-th field. */
+  template <std::size_t I>
+  using field_type = typename std::tuple_element<I, value_type>::type;
+
+  /** @brief Number of fields in a record. */
+  static constexpr size_type field_count = sizeof...(Fields);
+
+  /** @brief Default constructor. Constructs an empty container. */
+  ekusoa_vector() noexcept;
+
+  /** @brief Constructs the container with count value-initialized rows. */
+  explicit ekusoa_vector(size_type count);
+
+  /** @brief Copy constructor. */
+  ekusoa_vector(const ekusoa_vector &other);
+
+  /** @brief Move constructor. Takes over the memory block of other, which is
+   *         left empty. */
+  ekusoa_vector(ekusoa_vector &&other) noexcept;
+
+  /** @brief Copy assignment operator. */
+  ekusoa_vector &operator=(const ekusoa_vector &other);
+
+  /** @brief Move assignment operator. */
+  ekusoa_vector &operator=(ekusoa_vector &&other) noexcept;
+
+  /** @brief Destructor. */
+  ~ekusoa_vector();
+
+  /** @brief Returns a proxy to the fields of row pos. No bounds checking is
+   *         performed. */
+  reference operator[](size_type pos) noexcept;
+  const_reference operator[](size_type pos) const noexcept;
+
+  /** @brief Returns a proxy to the fields of row pos, with bounds
+   *         checking. */
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  /** @brief Returns proxies to the first and the last rows. */
+  reference front() noexcept;
+  const_reference front() const noexcept;
+  reference back() noexcept;
+  const_reference back() const noexcept;
+
+  /** @brief Returns a pointer to the size() contiguous values of the I-th
+   *         field. */
+  template <std::size_t I> field_type<I> *data() noexcept;
+  template <std::size_t I> const field_type<I> *data() const noexcept;
+
+  /** @brief Row iterators. */
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  /** @brief Checks if the container has no rows. */
+  bool empty() const noexcept;
+
+  /** @brief Returns the number of rows in the container. */
+  size_type size() const noexcept;
+
+  /** @brief Returns the number of rows that the container has currently
+   *         allocated space for. */
+  size_type capacity() const noexcept;
+
+  /** @brief Increases the capacity to a value that's greater or equal to
+   *         new_cap. */
+  void reserve(size_type new_cap);
+
+  /** @brief Requests the removal of unused capacity. */
+  void shrink_to_fit();
+
+  /** @brief Erases all rows from the container. */
+  void clear() noexcept;
+
+  /** @brief Appends a copy of record. */
+  void push_back(const value_type &record);
+
+  /** @brief Appends record using move semantics. */
+  void push_back(value_type &&record);
+
+  /** @brief Appends a row whose I-th field is constructed from the I-th
+   *         argument. */
+  template <class... Args> void emplace_back(Args &&... args);
+
+  /** @brief Removes the last row. */
+  void pop_back() noexcept;
+
+  /** @brief Resizes the container to contain count rows, appending
+   *         value-initialized rows if needed. */
+  void resize(size_type count);
+
+  /** @brief Exchanges the contents of the container with those of other. */
+  void swap(ekusoa_vector &other) noexcept;
+
+private:
+  using columns_type = std::tuple<Fields *...>;
+  using indices = std::index_sequence_for<Fields...>;
+  /* the unit memory blocks are made of, suitably aligned for any field */
+  using block_unit = std::max_align_t;
+
+  std::allocator<block_unit> block_allocator_;
+  /* element operations go through the default allocator traits */
+  std::allocator<value_type> element_allocator_;
+  block_unit *block_;
+  size_type capacity_;
+  size_type size_;
+  columns_type columns_;
+
+  /** @brief Returns the combined size of the fields of a row. */
+  static constexpr std::size_t row_bytes() noexcept;
+
+  /** @brief Returns the number of units in a block with room for capacity
+   *         rows. */
+  static std::size_t block_units(size_type capacity) noexcept;
+
+  /** @brief Returns the start of the columns of a block with room for
+   *         capacity rows. */
+  static columns_type carve(block_unit *block, size_type capacity) noexcept;
+  template <std::size_t... I>
+  static columns_type carve(block_unit *block, size_type capacity,
+                            std::index_sequence<I...>) noexcept;
+
+  /** @brief Calls visit(std::integral_constant<std::size_t, I>{}) for the
+   *         index I of each field. */
+  template <class Visit> static void for_each_field(Visit visit);
+  template <class Visit, std::size_t... I>
+  static void for_each_field(Visit &visit, std::index_sequence<I...>);
+
+  /** @brief Calls build(column, index) with count rows of uninitialized
+   *         storage from row first of each column of columns. If one of them
+   *         throws, the columns built so far are destroyed before
+   *         rethrowing. */
+  template <class Build>
+  void build_columns(const columns_type &columns, size_type first,
+                     size_type count, Build build);
+  template <class Build, std::size_t... I>
+  void build_columns(const columns_type &columns, size_type first,
+                     size_type count, Build &build, std::index_sequence<I...>);
+
+  /** @brief Destroys rows [first, last) of columns. */
+  void destroy_rows(const columns_type &columns, size_type first,
+                    size_type last) noexcept;
+
+  /** @brief Moves the rows into a new block with room for new_cap rows. */
+  void reallocate(size_type new_cap);
+
+  /** @brief Moves the rows, plus a new one constructed from args at the end,
+   *         into a new block. */
+  template <class... Args> void realloc_emplace_back(Args &&... args);
+
+  /** @brief Returns a new block with room for capacity rows, or nullptr if
+   *         capacity is zero. */
+  block_unit *allocate_block(size_type capacity);
+  void deallocate_block(block_unit *block, size_type capacity) noexcept;
+
+  template <std::size_t... I>
+  reference row(size_type pos, std::index_sequence<I...>) noexcept;
+  template <std::size_t... I>
+  const_reference row(size_type pos, std::index_sequence<I...>) const noexcept;
+
+  template <class Record, std::size_t... I>
+  void push_back_record(Record &&record, std::index_sequence<I...>);
+};
+
+/** @brief Random access iterator over the rows of an ekusoa_vector. It
+ *         dereferences to a row proxy. */
+template <class... Fields>
+template <bool Const>
+class ekusoa_vector<Fields...>::basic_iterator {
+  using container_type =
+      typename std::conditional<Const, const ekusoa_vector,
+                                ekusoa_vector>::type;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename ekusoa_vector::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      typename std::conditional<Const, typename ekusoa_vector::const_reference,
+                                typename ekusoa_vector::reference>::type;
+  using pointer = void;
+
+  basic_iterator() noexcept : container_{nullptr}, pos_{0} {}
+  basic_iterator(container_type *container, size_type pos) noexcept
+      : container_{container}, pos_{pos} {}
+
+  /* mutable iterators convert to const ones */
+  template <bool OtherConst,
+            class = typename std::enable_if<Const && !OtherConst>::type>
+  basic_iterator(const basic_iterator<OtherConst> &other) noexcept
+      : container_{other.container_}, pos_{other.pos_} {}
+
+  reference operator*() const noexcept { return (*container_)[pos_]; }
+  reference operator[](difference_type offset) const noexcept {
+    return (*container_)[pos_ + offset];
+  }
+
+  /** @brief Returns the index of the row pointed to, to address columns. */
+  size_type index() const noexcept { return pos_; }
+
+  basic_iterator &operator++() noexcept {
+    ++pos_;
+    return *this;
+  }
+  basic_iterator operator++(int) noexcept {
+    auto previous = *this;
+    ++pos_;
+    return previous;
+  }
+  basic_iterator &operator--() noexcept {
+    --pos_;
+    return *this;
+  }
+  basic_iterator operator--(int) noexcept {
+    auto previous = *this;
+    --pos_;
+    return previous;
+  }
+  basic_iterator &operator+=(difference_type offset) noexcept {
+    pos_ += offset;
+    return *this;
+  }
+  basic_iterator &operator-=(difference_type offset) noexcept {
+    pos_ -= offset;
+    return *this;
+  }
+  basic_iterator operator+(difference_type offset) const noexcept {
+    return basic_iterator(container_, pos_ + offset);
+  }
+  friend basic_iterator operator+(difference_type offset,
+                                  const basic_iterator &it) noexcept {
+    return it + offset;
+  }
+  basic_iterator operator-(difference_type offset) const noexcept {
+    return basic_iterator(container_, pos_ - offset);
+  }
+  difference_type operator-(const basic_iterator &other) const noexcept {
+    return static_cast<difference_type>(pos_) -
+           static_cast<difference_type>(other.pos_);
+  }
+
+  bool operator==(const basic_iterator &other) const noexcept {
+    return pos_ == other.pos_;
+  }
+  bool operator!=(const basic_iterator &other) const noexcept {
+    return pos_ != other.pos_;
+  }
+  bool operator<(const basic_iterator &other) const noexcept {
+    return pos_ < other.pos_;
+  }
+  bool operator>(const basic_iterator &other) const noexcept {
+    return pos_ > other.pos_;
+  }
+  bool operator<=(const basic_iterator &other) const noexcept {
+    return pos_ <= other.pos_;
+  }
+  bool operator>=(const basic_iterator &other) const noexcept {
+    return pos_ >= other.pos_;
+  }
+
+private:
+  template <bool> friend class basic_iterator;
+
+  container_type *container_;
+  size_type pos_;
+};
+
+template <class... Fields>
+constexpr typename ekusoa_vector<Fields...>::size_type
+    ekusoa_vector<Fields...>::field_count;
+
+template <class... Fields>
+ekusoa_vector<Fields...>::ekusoa_vector() noexcept
+    : block_allocator_{}, element_allocator_{}, block_{nullptr}, capacity_{0},
+      size_{0}, columns_{} {}
+
+template <class... Fields>
+ekusoa_vector<Fields...>::ekusoa_vector(size_type count) : ekusoa_vector() {
+  resize(count);
+}
+
+template <class... Fields>
+ekusoa_vector<Fields...>::ekusoa_vector(const ekusoa_vector &other)
+    : ekusoa_vector() {
+  reserve(other.size_);
+  build_columns(columns_, 0, other.size_, [&other, this](auto *dst,
+                                                         auto index) {
+    const auto *src = std::get<decltype(index)::value>(other.columns_);
+    detail::copy_construct_n(element_allocator_, src, other.size_, dst);
+  });
+  size_ = other.size_;
+}
+
+template <class... Fields>
+ekusoa_vector<Fields...>::ekusoa_vector(ekusoa_vector &&other) noexcept
+    : block_allocator_{}, element_allocator_{}, block_{other.block_},
+      capacity_{other.capacity_}, size_{other.size_},
+      columns_{other.columns_} {
+  other.block_ = nullptr;
+  other.capacity_ = 0;
+  other.size_ = 0;
+  other.columns_ = columns_type{};
+}
+
+template <class... Fields>
+ekusoa_vector<Fields...> &
+ekusoa_vector<Fields...>::operator=(const ekusoa_vector &other) {
+  if (this != &other) {
+    ekusoa_vector copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <class... Fields>
+ekusoa_vector<Fields...> &
+ekusoa_vector<Fields...>::operator=(ekusoa_vector &&other) noexcept {
+  if (this != &other) {
+    ekusoa_vector moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <class... Fields> ekusoa_vector<Fields...>::~ekusoa_vector() {
+  clear();
+  deallocate_block(block_, capacity_);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::reference
+    ekusoa_vector<Fields...>::operator[](size_type pos) noexcept {
+  return row(pos, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_reference
+    ekusoa_vector<Fields...>::operator[](size_type pos) const noexcept {
+  return row(pos, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::reference
+ekusoa_vector<Fields...>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("Out of range access to ekusoa_vector");
+  }
+  return row(pos, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_reference
+ekusoa_vector<Fields...>::at(size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("Out of range access to ekusoa_vector");
+  }
+  return row(pos, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::reference
+ekusoa_vector<Fields...>::front() noexcept {
+  return row(0, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_reference
+ekusoa_vector<Fields...>::front() const noexcept {
+  return row(0, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::reference
+ekusoa_vector<Fields...>::back() noexcept {
+  return row(size_ - 1, indices{});
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_reference
+ekusoa_vector<Fields...>::back() const noexcept {
+  return row(size_ - 1, indices{});
+}
+
+template <class... Fields>
+template <std::size_t I>
+typename ekusoa_vector<Fields...>::template field_type<I> *
+ekusoa_vector<Fields...>::data() noexcept {
+  return std::get<I>(columns_);
+}
+
+template <class... Fields>
+template <std::size_t I>
+const typename ekusoa_vector<Fields...>::template field_type<I> *
+ekusoa_vector<Fields...>::data() const noexcept {
+  return std::get<I>(columns_);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::iterator
+ekusoa_vector<Fields...>::begin() noexcept {
+  return iterator(this, 0);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_iterator
+ekusoa_vector<Fields...>::begin() const noexcept {
+  return const_iterator(this, 0);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_iterator
+ekusoa_vector<Fields...>::cbegin() const noexcept {
+  return const_iterator(this, 0);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::iterator
+ekusoa_vector<Fields...>::end() noexcept {
+  return iterator(this, size_);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_iterator
+ekusoa_vector<Fields...>::end() const noexcept {
+  return const_iterator(this, size_);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::const_iterator
+ekusoa_vector<Fields...>::cend() const noexcept {
+  return const_iterator(this, size_);
+}
+
+template <class... Fields>
+bool ekusoa_vector<Fields...>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::size_type
+ekusoa_vector<Fields...>::size() const noexcept {
+  return size_;
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::size_type
+ekusoa_vector<Fields...>::capacity() const noexcept {
+  return capacity_;
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::reserve(size_type new_cap) {
+  if (new_cap > capacity_) {
+    reallocate(growth_policy::fit_capacity(new_cap, row_bytes()));
+  }
+}
+
+template <class... Fields> void ekusoa_vector<Fields...>::shrink_to_fit() {
+  const auto new_cap = growth_policy::fit_capacity(size_, row_bytes());
+  if (new_cap < capacity_) {
+    reallocate(new_cap);
+  }
+}
+
+template <class... Fields> void ekusoa_vector<Fields...>::clear() noexcept {
+  destroy_rows(columns_, 0, size_);
+  size_ = 0;
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::push_back(const value_type &record) {
+  push_back_record(record, indices{});
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::push_back(value_type &&record) {
+  push_back_record(std::move(record), indices{});
+}
+
+template <class... Fields>
+template <class... Args>
+void ekusoa_vector<Fields...>::emplace_back(Args &&... args) {
+  static_assert(sizeof...(Args) == sizeof...(Fields),
+                "emplace_back() takes one argument per field");
+  if (size_ == capacity_) {
+    realloc_emplace_back(std::forward<Args>(args)...);
+    return;
+  }
+  auto fields = std::forward_as_tuple(std::forward<Args>(args)...);
+  build_columns(columns_, size_, 1, [&fields, this](auto *dst, auto index) {
+    detail::construct(element_allocator_, dst,
+                      std::get<decltype(index)::value>(std::move(fields)));
+  });
+  ++size_;
+}
+
+template <class... Fields> void ekusoa_vector<Fields...>::pop_back() noexcept {
+  --size_;
+  destroy_rows(columns_, size_, size_ + 1);
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::resize(size_type count) {
+  if (count <= size_) {
+    destroy_rows(columns_, count, size_);
+    size_ = count;
+    return;
+  }
+  if (count > capacity_) {
+    reallocate(growth_policy::next_capacity(capacity_, count, row_bytes()));
+  }
+  const auto added = count - size_;
+  build_columns(columns_, size_, added, [added, this](auto *dst, auto) {
+    detail::value_construct_n(element_allocator_, dst, added);
+  });
+  size_ = count;
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::swap(ekusoa_vector &other) noexcept {
+  std::swap(block_, other.block_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(columns_, other.columns_);
+}
+
+template <class... Fields>
+constexpr std::size_t ekusoa_vector<Fields...>::row_bytes() noexcept {
+  const std::size_t sizes[] = {sizeof(Fields)...};
+  std::size_t total = 0;
+  for (const auto size : sizes) {
+    total += size;
+  }
+  return total;
+}
+
+template <class... Fields>
+std::size_t
+ekusoa_vector<Fields...>::block_units(size_type capacity) noexcept {
+  /* each column starts at the first suitably aligned offset after the
+     previous one */
+  const std::size_t sizes[] = {sizeof(Fields)...};
+  const std::size_t alignments[] = {alignof(Fields)...};
+  std::size_t offset = 0;
+  for (std::size_t field = 0; field < sizeof...(Fields); ++field) {
+    offset = (offset + alignments[field] - 1) / alignments[field] *
+             alignments[field];
+    offset += capacity * sizes[field];
+  }
+  return (offset + sizeof(block_unit) - 1) / sizeof(block_unit);
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::columns_type
+ekusoa_vector<Fields...>::carve(block_unit *block,
+                                size_type capacity) noexcept {
+  if (!block) {
+    return columns_type{};
+  }
+  return carve(block, capacity, indices{});
+}
+
+template <class... Fields>
+template <std::size_t... I>
+typename ekusoa_vector<Fields...>::columns_type
+ekusoa_vector<Fields...>::carve(block_unit *block, size_type capacity,
+                                std::index_sequence<I...>) noexcept {
+  const std::size_t sizes[] = {sizeof(Fields)...};
+  const std::size_t alignments[] = {alignof(Fields)...};
+  void *starts[sizeof...(Fields)];
+  std::size_t offset = 0;
+  for (std::size_t field = 0; field < sizeof...(Fields); ++field) {
+    offset = (offset + alignments[field] - 1) / alignments[field] *
+             alignments[field];
+    starts[field] = reinterpret_cast<unsigned char *>(block) + offset;
+    offset += capacity * sizes[field];
+  }
+  return columns_type{static_cast<Fields *>(starts[I])...};
+}
+
+template <class... Fields>
+template <class Visit>
+void ekusoa_vector<Fields...>::for_each_field(Visit visit) {
+  for_each_field(visit, indices{});
+}
+
+template <class... Fields>
+template <class Visit, std::size_t... I>
+void ekusoa_vector<Fields...>::for_each_field(Visit &visit,
+                                              std::index_sequence<I...>) {
+  using expand = int[];
+  (void)expand{0, (visit(std::integral_constant<std::size_t, I>{}), 0)...};
+}
+
+template <class... Fields>
+template <class Build>
+void ekusoa_vector<Fields...>::build_columns(const columns_type &columns,
+                                             size_type first, size_type count,
+                                             Build build) {
+  build_columns(columns, first, count, build, indices{});
+}
+
+template <class... Fields>
+template <class Build, std::size_t... I>
+void ekusoa_vector<Fields...>::build_columns(const columns_type &columns,
+                                             size_type first, size_type count,
+                                             Build &build,
+                                             std::index_sequence<I...>) {
+  std::size_t built = 0;
+  try {
+    using expand = int[];
+    (void)expand{0, (build(std::get<I>(columns) + first,
+                           std::integral_constant<std::size_t, I>{}),
+                     ++built, 0)...};
+  } catch (...) {
+    using expand = int[];
+    (void)expand{0, (I < built ? detail::destroy_range(
+                                     element_allocator_,
+                                     std::get<I>(columns) + first,
+                                     std::get<I>(columns) + first + count)
+                               : void(),
+                     0)...};
+    throw;
+  }
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::destroy_rows(const columns_type &columns,
+                                            size_type first,
+                                            size_type last) noexcept {
+  for_each_field([&columns, first, last, this](auto index) {
+    const auto column = std::get<decltype(index)::value>(columns);
+    detail::destroy_range(element_allocator_, column + first, column + last);
+  });
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::reallocate(size_type new_cap) {
+  auto new_block = allocate_block(new_cap);
+  const auto new_columns = carve(new_block, new_cap);
+  /* moving the fields can't throw */
+  for_each_field([&new_columns, this](auto index) {
+    constexpr auto field = decltype(index)::value;
+    detail::relocate_forward(element_allocator_, std::get<field>(new_columns),
+                             std::get<field>(columns_), size_);
+  });
+  deallocate_block(block_, capacity_);
+  block_ = new_block;
+  capacity_ = new_cap;
+  columns_ = new_columns;
+}
+
+template <class... Fields>
+template <class... Args>
+void ekusoa_vector<Fields...>::realloc_emplace_back(Args &&... args) {
+  const auto new_cap =
+      growth_policy::next_capacity(capacity_, size_ + 1, row_bytes());
+  auto new_block = allocate_block(new_cap);
+  const auto new_columns = carve(new_block, new_cap);
+
+  /* args may refer to fields of this container, so the new row must be built
+     before the old ones get moved away */
+  try {
+    auto fields = std::forward_as_tuple(std::forward<Args>(args)...);
+    build_columns(new_columns, size_, 1, [&fields, this](auto *dst,
+                                                         auto index) {
+      detail::construct(element_allocator_, dst,
+                        std::get<decltype(index)::value>(std::move(fields)));
+    });
+  } catch (...) {
+    deallocate_block(new_block, new_cap);
+    throw;
+  }
+  for_each_field([&new_columns, this](auto index) {
+    constexpr auto field = decltype(index)::value;
+    detail::relocate_forward(element_allocator_, std::get<field>(new_columns),
+                             std::get<field>(columns_), size_);
+  });
+  deallocate_block(block_, capacity_);
+  block_ = new_block;
+  capacity_ = new_cap;
+  columns_ = new_columns;
+  ++size_;
+}
+
+template <class... Fields>
+typename ekusoa_vector<Fields...>::block_unit *
+ekusoa_vector<Fields...>::allocate_block(size_type capacity) {
+  if (!capacity) {
+    return nullptr;
+  }
+  if (capacity > SIZE_MAX / sizeof(block_unit) / row_bytes()) {
+    throw std::length_error("ekusoa_vector capacity is too large");
+  }
+  return block_allocator_.allocate(block_units(capacity));
+}
+
+template <class... Fields>
+void ekusoa_vector<Fields...>::deallocate_block(block_unit *block,
+                                                size_type capacity) noexcept {
+  if (block) {
+    block_allocator_.deallocate(block, block_units(capacity));
+  }
+}
+
+template <class... Fields>
+template <std::size_t... I>
+typename ekusoa_vector<Fields...>::reference
+ekusoa_vector<Fields...>::row(size_type pos,
+                              std::index_sequence<I...>) noexcept {
+  return reference(std::get<I>(columns_)[pos]...);
+}
+
+template <class... Fields>
+template <std::size_t... I>
+typename ekusoa_vector<Fields...>::const_reference
+ekusoa_vector<Fields...>::row(size_type pos,
+                              std::index_sequence<I...>) const noexcept {
+  return const_reference(std::get<I>(columns_)[pos]...);
+}
+
+template <class... Fields>
+template <class Record, std::size_t... I>
+void ekusoa_vector<Fields...>::push_back_record(Record &&record,
+                                                std::index_sequence<I...>) {
+  emplace_back(std::get<I>(std::forward<Record>(record))...);
+}
+
+/*
+ * *** NON MEMBERS ***
+ * */
+
+template <class... Fields>
+void swap(ekusoa_vector<Fields...> &lhs,
+          ekusoa_vector<Fields...> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}; // namespace ekustd
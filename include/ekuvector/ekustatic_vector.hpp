@@ -0,0 +1,935 @@
+/**
+ * ekustatic_vector, vector with a fixed capacity and no allocator.
+ * @author Gerardo Puga
+ * */
+
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+namespace detail {
+
+/** @brief Smallest unsigned integer type able to hold the value N. */
+template <std::size_t N>
+using smallest_size_type = typename std::conditional<
+    N <= UINT8_MAX, std::uint8_t,
+    typename std::conditional<
+        N <= UINT16_MAX, std::uint16_t,
+        typename std::conditional<N <= UINT32_MAX, std::uint32_t,
+                                  std::uint64_t>::type>::type>::type;
+
+/** @brief Inline storage for up to N elements, plus their count.
+ *
+ * Trivial types are kept in a plain array, which is what lets the container
+ * be used in constant expressions: the special members are all implicit, and
+ * constructing an element is an assignment. The price is that the whole array
+ * is zeroed on construction. */
+template <class Type, std::size_t N,
+          bool Trivial = std::is_trivial<Type>::value>
+struct static_storage {
+  using size_type = smallest_size_type<N>;
+
+  constexpr static_storage() noexcept : elements_{}, size_{0} {}
+
+  constexpr Type *data() noexcept { return elements_; }
+  constexpr const Type *data() const noexcept { return elements_; }
+
+  template <class... Args>
+  constexpr void construct(std::size_t pos, Args &&... args) {
+    elements_[pos] = Type(std::forward<Args>(args)...);
+  }
+  constexpr void destroy(std::size_t /* pos */) noexcept {}
+
+  Type elements_[N];
+  size_type size_;
+};
+
+/** @brief Inline storage for up to N elements of a non-trivial type, which
+ *         are constructed in place and destroyed along with the storage. */
+template <class Type, std::size_t N> struct static_storage<Type, N, false> {
+  using size_type = smallest_size_type<N>;
+
+  static_storage() noexcept : size_{0} {}
+
+  static_storage(const static_storage &other) : size_{0} {
+    construct_from(other.data(), other.size_);
+  }
+
+  static_storage(static_storage &&other) noexcept(
+      std::is_nothrow_move_constructible<Type>::value)
+      : size_{0} {
+    construct_from(std::make_move_iterator(other.data()), other.size_);
+  }
+
+  ~static_storage() { truncate(0); }
+
+  static_storage &operator=(const static_storage &other) {
+    if (this != &other) {
+      truncate(0);
+      append_from(other.data(), other.size_);
+    }
+    return *this;
+  }
+
+  static_storage &operator=(static_storage &&other) noexcept(
+      std::is_nothrow_move_constructible<Type>::value) {
+    if (this != &other) {
+      truncate(0);
+      append_from(std::make_move_iterator(other.data()), other.size_);
+    }
+    return *this;
+  }
+
+  Type *data() noexcept { return reinterpret_cast<Type *>(elements_); }
+  const Type *data() const noexcept {
+    return reinterpret_cast<const Type *>(elements_);
+  }
+
+  template <class... Args> void construct(std::size_t pos, Args &&... args) {
+    ::new (static_cast<void *>(data() + pos)) Type(std::forward<Args>(args)...);
+  }
+  void destroy(std::size_t pos) noexcept { data()[pos].~Type(); }
+
+  /* size_ is bumped after each element, so that a throwing constructor
+     leaves the elements built so far accounted for */
+  template <class InputIt> void append_from(InputIt first, std::size_t count) {
+    for (std::size_t index = 0; index < count; ++index, ++first) {
+      construct(size_, *first);
+      ++size_;
+    }
+  }
+
+  /* the destructor won't run if a constructor throws */
+  template <class InputIt>
+  void construct_from(InputIt first, std::size_t count) {
+    try {
+      append_from(first, count);
+    } catch (...) {
+      truncate(0);
+      throw;
+    }
+  }
+
+  void truncate(std::size_t count) noexcept {
+    while (size_ > count) {
+      destroy(--size_);
+    }
+  }
+
+  typename std::aligned_storage<sizeof(Type), alignof(Type)>::type
+      elements_[N];
+  size_type size_;
+};
+
+} // namespace detail
+
+/** @brief Vector with room for exactly N elements inside the object itself,
+ *         that never touches an allocator.
+ *
+ * It shares the interface of ekuvector, but growing past N elements throws
+ * std::length_error instead of reallocating. There are no capacity_ or data_
+ * members: the object is the N elements followed by a size field of the
+ * smallest unsigned type that can hold N.
+ *
+ * For trivial types every member function except the reverse iterator ones is
+ * constexpr, so tables can be built at compile time. */
+template <class Type, std::size_t N> class ekustatic_vector {
+  static_assert(N > 0, "an ekustatic_vector must have room for an element");
+
+public:
+  using type = Type;
+  using reference = Type &;
+  using const_reference = const Type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = Type;
+
+  using pointer = Type *;
+  using const_pointer = const Type *;
+
+  using iterator = Type *;
+  using const_iterator = const Type *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /** @brief Default constructor. Constructs an empty container. */
+  constexpr ekustatic_vector() noexcept = default;
+
+  /** @brief Constructs the container with count default-inserted instances of
+   *         Type. */
+  constexpr explicit ekustatic_vector(size_type count);
+
+  /** @brief Constructs the container with count copies of value. */
+  constexpr ekustatic_vector(size_type count, const Type &value);
+
+  /** @brief Constructs the container with the contents of the range [first,
+   *         last). */
+  template <class InputIt>
+  constexpr ekustatic_vector(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type
+          last);
+
+  /** @brief Constructs the container with the contents of the initializer list
+   *         init. */
+  constexpr ekustatic_vector(std::initializer_list<Type> init);
+
+  /** @brief Replaces the contents with those of the initializer list
+   *         ilist. */
+  constexpr ekustatic_vector &operator=(std::initializer_list<Type> ilist);
+
+  /** @brief Replaces the contents with count copies of value. */
+  constexpr void assign(size_type count, const Type &value);
+
+  /** @brief Replaces the contents with copies of those in the range [first,
+   *         last). */
+  template <class InputIt>
+  constexpr void assign(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type
+          last);
+
+  /** @brief Replaces the contents with the elements of the initializer list
+   *         ilist. */
+  constexpr void assign(std::initializer_list<Type> ilist);
+
+  /** @brief Returns a reference to the element at specified location pos, with
+   *         bounds checking. */
+  constexpr reference at(size_type pos);
+  constexpr const_reference at(size_type pos) const;
+
+  /** @brief Returns a reference to the element at specified location pos. No
+   *         bounds checking is performed. */
+  constexpr reference operator[](size_type pos) noexcept;
+  constexpr const_reference operator[](size_type pos) const noexcept;
+
+  /** @brief Returns a reference to the first element in the container. */
+  constexpr reference front() noexcept;
+  constexpr const_reference front() const noexcept;
+
+  /** @brief Returns reference to the last element in the container. */
+  constexpr reference back() noexcept;
+  constexpr const_reference back() const noexcept;
+
+  /** @brief Returns pointer to the underlying array serving as element
+   *         storage. */
+  constexpr Type *data() noexcept;
+  constexpr const Type *data() const noexcept;
+
+  /** @brief Iterators to the beginning of the container. */
+  constexpr iterator begin() noexcept;
+  constexpr const_iterator begin() const noexcept;
+  constexpr const_iterator cbegin() const noexcept;
+
+  /** @brief Iterators to the end of the container. */
+  constexpr iterator end() noexcept;
+  constexpr const_iterator end() const noexcept;
+  constexpr const_iterator cend() const noexcept;
+
+  /** @brief Reverse iterators to the beginning of the reversed container. */
+  reverse_iterator rbegin() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator crbegin() const noexcept;
+
+  /** @brief Reverse iterators to the end of the reversed container. */
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rend() const noexcept;
+  const_reverse_iterator crend() const noexcept;
+
+  /** @brief Checks if the container has no elements. */
+  constexpr bool empty() const noexcept;
+
+  /** @brief Returns the number of elements in the container. */
+  constexpr size_type size() const noexcept;
+
+  /** @brief Returns the maximum number of elements the container is able to
+   *         hold, which is N. */
+  constexpr size_type max_size() const noexcept;
+
+  /** @brief Does nothing, other than throwing std::length_error if new_cap is
+   *         larger than N. */
+  constexpr void reserve(size_type new_cap);
+
+  /** @brief Returns the number of elements that the container has room
+   *         for, which is N. */
+  constexpr size_type capacity() const noexcept;
+
+  /** @brief Does nothing, as the storage can't be shrunk. */
+  constexpr void shrink_to_fit() noexcept;
+
+  /** @brief Erases all elements from the container. */
+  constexpr void clear() noexcept;
+
+  /** @brief Inserts value before pos. */
+  constexpr iterator insert(const_iterator pos, const Type &value);
+  constexpr iterator insert(const_iterator pos, Type &&value);
+
+  /** @brief Inserts count copies of value before pos. */
+  constexpr iterator insert(const_iterator pos, size_type count,
+                            const Type &value);
+
+  /** @brief Inserts elements from the range [first, last) before pos. */
+  template <class InputIt>
+  constexpr iterator insert(
+      const_iterator pos, InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type
+          last);
+
+  /** @brief Inserts elements from initializer list ilist before pos. */
+  constexpr iterator insert(const_iterator pos,
+                            std::initializer_list<Type> ilist);
+
+  /** @brief Inserts a new element constructed from args directly before
+   *         pos. */
+  template <class... Args>
+  constexpr iterator emplace(const_iterator pos, Args &&... args);
+
+  /** @brief Removes the element at pos. */
+  constexpr iterator erase(const_iterator pos);
+
+  /** @brief Removes the elements in the range [first, last). */
+  constexpr iterator erase(const_iterator first, const_iterator last);
+
+  /** @brief Appends the given element value to the end of the container.
+   *         Throws std::length_error if the container is full. */
+  constexpr void push_back(const Type &value);
+  constexpr void push_back(Type &&value);
+
+  /** @brief Appends a new element constructed from args to the end of the
+   *         container. Throws std::length_error if the container is full. */
+  template <class... Args> constexpr reference emplace_back(Args &&... args);
+
+  /** @brief Removes the last element of the container. */
+  constexpr void pop_back() noexcept;
+
+  /** @brief Resizes the container to contain count elements, appending
+   *         default-inserted elements if needed. */
+  constexpr void resize(size_type count);
+
+  /** @brief Resizes the container to contain count elements, appending copies
+   *         of value if needed. */
+  constexpr void resize(size_type count, const value_type &value);
+
+  /** @brief Exchanges the contents of the container with those of other,
+   *         element by element. */
+  constexpr void swap(ekustatic_vector &other) noexcept(
+      std::is_nothrow_move_constructible<Type>::value &&
+      std::is_nothrow_move_assignable<Type>::value);
+
+private:
+  detail::static_storage<Type, N> storage_;
+
+  /** @brief Throws std::length_error if count more elements don't fit. */
+  constexpr void check_room(size_type count, const char *what) const;
+
+  /** @brief Destroys the elements past the first count ones. */
+  constexpr void truncate(size_type count) noexcept;
+
+  /* constructing trivial elements can't throw, and try blocks aren't allowed
+     in constexpr functions before C++20 */
+  using trivial_tag =
+      std::integral_constant<bool, std::is_trivial<Type>::value>;
+
+  /** @brief Appends the elements of the range [first, last), removing them
+   *         all again if one of them throws. */
+  template <class InputIt> constexpr void append(InputIt first, InputIt last);
+  template <class InputIt>
+  constexpr void append(InputIt first, InputIt last, std::true_type);
+  template <class InputIt>
+  void append(InputIt first, InputIt last, std::false_type);
+
+  /** @brief Appends count default-inserted elements, removing them all again if
+   *         one of them throws. */
+  constexpr void append_default(size_type count, std::true_type);
+  void append_default(size_type count, std::false_type);
+
+  /** @brief Appends count copies of value, removing them all again if one of
+   *         them throws. */
+  constexpr void append(size_type count, const Type &value);
+  constexpr void append(size_type count, const Type &value, std::true_type);
+  void append(size_type count, const Type &value, std::false_type);
+
+  /** @brief Moves the elements appended after the first old_size ones to
+   *         ordinal, and returns an iterator to the first of them. */
+  constexpr iterator rotate_appended(size_type ordinal, size_type old_size);
+
+  /** @brief Exchanges the values of lhs and rhs. std::swap() isn't constexpr
+   *         before C++20. */
+  static constexpr void swap_values(Type &lhs, Type &rhs);
+
+  /** @brief Reverses the order of the elements in [first, last). */
+  static constexpr void reverse(Type *first, Type *last);
+};
+
+template <class Type, std::size_t N>
+constexpr ekustatic_vector<Type, N>::ekustatic_vector(size_type count)
+    : ekustatic_vector() {
+  resize(count);
+}
+
+template <class Type, std::size_t N>
+constexpr ekustatic_vector<Type, N>::ekustatic_vector(size_type count,
+                                                      const Type &value)
+    : ekustatic_vector() {
+  append(count, value);
+}
+
+template <class Type, std::size_t N>
+template <class InputIt>
+constexpr ekustatic_vector<Type, N>::ekustatic_vector(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last)
+    : ekustatic_vector() {
+  append(first, last);
+}
+
+template <class Type, std::size_t N>
+constexpr ekustatic_vector<Type, N>::ekustatic_vector(
+    std::initializer_list<Type> init)
+    : ekustatic_vector() {
+  append(init.begin(), init.end());
+}
+
+template <class Type, std::size_t N>
+constexpr ekustatic_vector<Type, N> &ekustatic_vector<Type, N>::
+operator=(std::initializer_list<Type> ilist) {
+  assign(ilist);
+  return *this;
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::assign(size_type count,
+                                                 const Type &value) {
+  reserve(count);
+  clear();
+  append(count, value);
+}
+
+template <class Type, std::size_t N>
+template <class InputIt>
+constexpr void ekustatic_vector<Type, N>::assign(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  clear();
+  append(first, last);
+}
+
+template <class Type, std::size_t N>
+constexpr void
+ekustatic_vector<Type, N>::assign(std::initializer_list<Type> ilist) {
+  reserve(ilist.size());
+  clear();
+  append(ilist.begin(), ilist.end());
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::reference
+ekustatic_vector<Type, N>::at(size_type pos) {
+  if (pos >= storage_.size_) {
+    throw std::out_of_range("Out of range access to ekustatic_vector");
+  }
+  return storage_.data()[pos];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_reference
+ekustatic_vector<Type, N>::at(size_type pos) const {
+  if (pos >= storage_.size_) {
+    throw std::out_of_range("Out of range access to ekustatic_vector");
+  }
+  return storage_.data()[pos];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::reference
+    ekustatic_vector<Type, N>::operator[](size_type pos) noexcept {
+  return storage_.data()[pos];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_reference
+    ekustatic_vector<Type, N>::operator[](size_type pos) const noexcept {
+  return storage_.data()[pos];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::reference
+ekustatic_vector<Type, N>::front() noexcept {
+  return storage_.data()[0];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_reference
+ekustatic_vector<Type, N>::front() const noexcept {
+  return storage_.data()[0];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::reference
+ekustatic_vector<Type, N>::back() noexcept {
+  return storage_.data()[storage_.size_ - 1];
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_reference
+ekustatic_vector<Type, N>::back() const noexcept {
+  return storage_.data()[storage_.size_ - 1];
+}
+
+template <class Type, std::size_t N>
+constexpr Type *ekustatic_vector<Type, N>::data() noexcept {
+  return storage_.data();
+}
+
+template <class Type, std::size_t N>
+constexpr const Type *ekustatic_vector<Type, N>::data() const noexcept {
+  return storage_.data();
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::begin() noexcept {
+  return storage_.data();
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_iterator
+ekustatic_vector<Type, N>::begin() const noexcept {
+  return storage_.data();
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_iterator
+ekustatic_vector<Type, N>::cbegin() const noexcept {
+  return storage_.data();
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::end() noexcept {
+  return storage_.data() + storage_.size_;
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_iterator
+ekustatic_vector<Type, N>::end() const noexcept {
+  return storage_.data() + storage_.size_;
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::const_iterator
+ekustatic_vector<Type, N>::cend() const noexcept {
+  return storage_.data() + storage_.size_;
+}
+
+template <class Type, std::size_t N>
+typename ekustatic_vector<Type, N>::reverse_iterator
+ekustatic_vector<Type, N>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+template <class Type, std::size_t N>
+typename ekustatic_vector<Type, N>::const_reverse_iterator
+ekustatic_vector<Type, N>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template <class Type, std::size_t N>
+typename ekustatic_vector<Type, N>::const_reverse_iterator
+ekustatic_vector<Type, N>::crbegin() const noexcept {
+  return const_reverse_iterator(cend());
+}
+
+template <class Type, std::size_t N>
+typename ekustatic_vector<Type, N>::reverse_iterator
+ekustatic_vector<Type, N>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+template <class Type, std::size_t N>
+typename ekustatic_vector<Type, N>::const_reverse_iterator
+ekustatic_vector<Type, N>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+template <class Type, std::size_t N>
+typename ekustatic_vector<Type, N>::const_reverse_iterator
+ekustatic_vector<Type, N>::crend() const noexcept {
+  return const_reverse_iterator(cbegin());
+}
+
+template <class Type, std::size_t N>
+constexpr bool ekustatic_vector<Type, N>::empty() const noexcept {
+  return storage_.size_ == 0;
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::size_type
+ekustatic_vector<Type, N>::size() const noexcept {
+  return storage_.size_;
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::size_type
+ekustatic_vector<Type, N>::max_size() const noexcept {
+  return N;
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::reserve(size_type new_cap) {
+  if (new_cap > N) {
+    throw std::length_error("ekustatic_vector::reserve");
+  }
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::size_type
+ekustatic_vector<Type, N>::capacity() const noexcept {
+  return N;
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::shrink_to_fit() noexcept {}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::clear() noexcept {
+  truncate(0);
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::insert(const_iterator pos, const Type &value) {
+  return emplace(pos, value);
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::insert(const_iterator pos, Type &&value) {
+  return emplace(pos, std::move(value));
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::insert(const_iterator pos, size_type count,
+                                  const Type &value) {
+  const size_type ordinal = pos - cbegin();
+  const size_type old_size = storage_.size_;
+  append(count, value);
+  return rotate_appended(ordinal, old_size);
+}
+
+template <class Type, std::size_t N>
+template <class InputIt>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::insert(
+    const_iterator pos, InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  const size_type ordinal = pos - cbegin();
+  const size_type old_size = storage_.size_;
+  append(first, last);
+  return rotate_appended(ordinal, old_size);
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::insert(const_iterator pos,
+                                  std::initializer_list<Type> ilist) {
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+template <class Type, std::size_t N>
+template <class... Args>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::emplace(const_iterator pos, Args &&... args) {
+  const size_type ordinal = pos - cbegin();
+  const size_type old_size = storage_.size_;
+  emplace_back(std::forward<Args>(args)...);
+  return rotate_appended(ordinal, old_size);
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::erase(const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::erase(const_iterator first, const_iterator last) {
+  const size_type ordinal = first - cbegin();
+  const size_type gap = last - first;
+  if (gap > 0) {
+    auto elements = storage_.data();
+    for (size_type index = ordinal + gap; index < storage_.size_; ++index) {
+      elements[index - gap] = std::move(elements[index]);
+    }
+    truncate(storage_.size_ - gap);
+  }
+  return begin() + ordinal;
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::push_back(const Type &value) {
+  emplace_back(value);
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::push_back(Type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <class Type, std::size_t N>
+template <class... Args>
+constexpr typename ekustatic_vector<Type, N>::reference
+ekustatic_vector<Type, N>::emplace_back(Args &&... args) {
+  check_room(1, "ekustatic_vector::emplace_back");
+  storage_.construct(storage_.size_, std::forward<Args>(args)...);
+  ++storage_.size_;
+  return back();
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::pop_back() noexcept {
+  storage_.destroy(--storage_.size_);
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::resize(size_type count) {
+  reserve(count);
+  if (count > storage_.size_) {
+    append_default(count - storage_.size_, trivial_tag{});
+  }
+  truncate(count);
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::resize(size_type count,
+                                                 const value_type &value) {
+  reserve(count);
+  if (count > storage_.size_) {
+    append(count - storage_.size_, value);
+  }
+  truncate(count);
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::swap(
+    ekustatic_vector &other) noexcept(std::is_nothrow_move_constructible<
+                                          Type>::value &&
+                                      std::is_nothrow_move_assignable<
+                                          Type>::value) {
+  auto &shorter = storage_.size_ < other.storage_.size_ ? *this : other;
+  auto &longer = storage_.size_ < other.storage_.size_ ? other : *this;
+  const size_type common = shorter.storage_.size_;
+  for (size_type index = 0; index < common; ++index) {
+    swap_values(storage_.data()[index], other.storage_.data()[index]);
+  }
+  for (size_type index = common; index < longer.storage_.size_; ++index) {
+    shorter.emplace_back(std::move(longer.storage_.data()[index]));
+  }
+  longer.truncate(common);
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::check_room(size_type count,
+                                                     const char *what) const {
+  if (count > N - storage_.size_) {
+    throw std::length_error(what);
+  }
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::truncate(size_type count) noexcept {
+  while (storage_.size_ > count) {
+    storage_.destroy(--storage_.size_);
+  }
+}
+
+template <class Type, std::size_t N>
+template <class InputIt>
+constexpr void ekustatic_vector<Type, N>::append(InputIt first, InputIt last) {
+  append(first, last, trivial_tag{});
+}
+
+template <class Type, std::size_t N>
+template <class InputIt>
+constexpr void ekustatic_vector<Type, N>::append(InputIt first, InputIt last,
+                                                 std::true_type) {
+  const size_type old_size = storage_.size_;
+  for (; first != last; ++first) {
+    if (storage_.size_ == N) {
+      /* the rest of the range doesn't fit, so the elements appended so far
+         are removed again before giving up */
+      truncate(old_size);
+      throw std::length_error("ekustatic_vector::insert");
+    }
+    storage_.construct(storage_.size_, *first);
+    ++storage_.size_;
+  }
+}
+
+template <class Type, std::size_t N>
+template <class InputIt>
+void ekustatic_vector<Type, N>::append(InputIt first, InputIt last,
+                                       std::false_type) {
+  const size_type old_size = storage_.size_;
+  try {
+    append(first, last, std::true_type{});
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::append_default(size_type count,
+                                                         std::true_type) {
+  check_room(count, "ekustatic_vector::resize");
+  for (size_type index = 0; index < count; ++index) {
+    emplace_back();
+  }
+}
+
+template <class Type, std::size_t N>
+void ekustatic_vector<Type, N>::append_default(size_type count,
+                                               std::false_type) {
+  const size_type old_size = storage_.size_;
+  try {
+    append_default(count, std::true_type{});
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::append(size_type count,
+                                                 const Type &value) {
+  append(count, value, trivial_tag{});
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::append(size_type count,
+                                                 const Type &value,
+                                                 std::true_type) {
+  check_room(count, "ekustatic_vector::insert");
+  for (size_type index = 0; index < count; ++index) {
+    emplace_back(value);
+  }
+}
+
+template <class Type, std::size_t N>
+void ekustatic_vector<Type, N>::append(size_type count, const Type &value,
+                                       std::false_type) {
+  const size_type old_size = storage_.size_;
+  try {
+    append(count, value, std::true_type{});
+  } catch (...) {
+    truncate(old_size);
+    throw;
+  }
+}
+
+template <class Type, std::size_t N>
+constexpr typename ekustatic_vector<Type, N>::iterator
+ekustatic_vector<Type, N>::rotate_appended(size_type ordinal,
+                                           size_type old_size) {
+  /* std::rotate() isn't constexpr before C++20 */
+  auto elements = storage_.data();
+  reverse(elements + ordinal, elements + old_size);
+  reverse(elements + old_size, elements + storage_.size_);
+  reverse(elements + ordinal, elements + storage_.size_);
+  return elements + ordinal;
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::swap_values(Type &lhs, Type &rhs) {
+  Type tmp(std::move(lhs));
+  lhs = std::move(rhs);
+  rhs = std::move(tmp);
+}
+
+template <class Type, std::size_t N>
+constexpr void ekustatic_vector<Type, N>::reverse(Type *first, Type *last) {
+  while ((first != last) && (first != --last)) {
+    swap_values(*first++, *last);
+  }
+}
+
+/*
+ * *** NON MEMBERS ***
+ * */
+
+template <class Type, std::size_t N>
+constexpr bool operator==(const ekustatic_vector<Type, N> &lhs,
+                          const ekustatic_vector<Type, N> &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (std::size_t index = 0; index < lhs.size(); ++index) {
+    if (!(lhs[index] == rhs[index])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class Type, std::size_t N>
+constexpr bool operator!=(const ekustatic_vector<Type, N> &lhs,
+                          const ekustatic_vector<Type, N> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class Type, std::size_t N>
+constexpr bool operator<(const ekustatic_vector<Type, N> &lhs,
+                         const ekustatic_vector<Type, N> &rhs) {
+  for (std::size_t index = 0; index < lhs.size(); ++index) {
+    if (index == rhs.size() || rhs[index] < lhs[index]) {
+      return false;
+    }
+    if (lhs[index] < rhs[index]) {
+      return true;
+    }
+  }
+  return lhs.size() < rhs.size();
+}
+
+template <class Type, std::size_t N>
+constexpr bool operator<=(const ekustatic_vector<Type, N> &lhs,
+                          const ekustatic_vector<Type, N> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <class Type, std::size_t N>
+constexpr bool operator>(const ekustatic_vector<Type, N> &lhs,
+                         const ekustatic_vector<Type, N> &rhs) {
+  return rhs < lhs;
+}
+
+template <class Type, std::size_t N>
+constexpr bool operator>=(const ekustatic_vector<Type, N> &lhs,
+                          const ekustatic_vector<Type, N> &rhs) {
+  return !(lhs < rhs);
+}
+
+template <class Type, std::size_t N>
+constexpr void
+swap(ekustatic_vector<Type, N> &lhs,
+     ekustatic_vector<Type, N> &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+}; // namespace ekustd
@@ -7,13 +7,43 @@
 
 // Standard library
 #include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
+/* keeps the slow paths of the hottest members out of their callers, so that
+   the common case compiles down to a few instructions */
+#if defined(__GNUC__) || defined(__clang__)
+#define EKUVECTOR_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define EKUVECTOR_NOINLINE __declspec(noinline)
+#else
+#define EKUVECTOR_NOINLINE
+#endif
+
+/* defining EKUVECTOR_CHECKED turns iterators into checked_iterator objects
+   that detect use after a reallocation, and makes indexing, front(), back()
+   and the members taking positions validate their arguments. Failed checks
+   print a message and abort(). Without it, iterators are plain pointers and
+   none of the checks generate any code */
+#if defined(EKUVECTOR_CHECKED)
+#define EKUVECTOR_CHECK(condition, message)                                    \
+  ((condition) ? static_cast<void>(0)                                          \
+               : ::ekustd::detail::check_failed(message, __FILE__, __LINE__))
+#else
+#define EKUVECTOR_CHECK(condition, message) static_cast<void>(0)
+#endif
+
 namespace ekustd {
 
 template <class, class Enable = void> struct is_iterator : std::false_type {};
@@ -24,7 +54,788 @@ struct is_iterator<T, typename std::enable_if<
                       >::value
                   >::type> : std::true_type {};
 
-template <class Type, class Allocator = std::allocator<Type>> class ekuvector {
+/** @brief Tells whether objects of type T can be relocated (moved to a new
+ *         address, ending the lifetime of the original) by copying their bytes.
+ *
+ * This is true for every trivially copyable type, and it can be opted into by
+ * specializing this trait for types such as std::unique_ptr, whose move
+ * constructor plus destructor pair amounts to a plain byte copy. */
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/** @brief Tells whether T is an execution policy, selecting the overloads of
+ *         the bulk members that split their work across threads.
+ *
+ * An execution policy must provide the member function
+ *
+ *   template <class Work, class Undo>
+ *   void for_each_chunk(std::size_t count, Work work, Undo undo) const;
+ *
+ * which calls work(first, last) over disjoint chunks of consecutive ordinals
+ * covering [0, count), possibly from several threads at once. A work call that
+ * throws leaves nothing of its own chunk behind. If any of them throws, the
+ * policy calls undo(first, last) for every chunk that did complete, and then
+ * rethrows one of the exceptions. When work can't throw, for_each_chunk()
+ * must not throw either and has to be declared so, since clear(policy) is
+ * noexcept and would otherwise lose track of the elements it destroyed.
+ * Policies backed by a thread pool opt in by specializing this trait; see
+ * ekuparallel_policy for a ready-made one. */
+template <class T> struct is_execution_policy : std::false_type {};
+
+/*
+ * *** GROWTH POLICIES ***
+ *
+ * A growth policy decides the capacity the container reallocates to when it
+ * runs out of space. It must provide the static member functions
+ *
+ *   std::size_t next_capacity(std::size_t current_cap, std::size_t required,
+ *                             std::size_t element_size);
+ *   std::size_t fit_capacity(std::size_t required, std::size_t element_size);
+ *
+ * The first one is used when growing, and the second one when reserving room
+ * or shrinking the storage to fit the contents. Both must return a value
+ * greater or equal to required.
+ * */
+
+/** @brief Multiplies the current capacity by Numerator / Denominator each time
+ *         the container runs out of space, which gives amortized O(1) growth.
+ * */
+template <std::size_t Numerator = 2, std::size_t Denominator = 1>
+struct geometric_growth {
+  static_assert(Numerator > Denominator, "the growth factor must exceed 1");
+
+  static std::size_t next_capacity(std::size_t current_cap,
+                                   std::size_t required,
+                                   std::size_t /* element_size */) noexcept {
+    const auto max_cap = SIZE_MAX / Numerator;
+    const auto grown_cap = (current_cap < max_cap)
+                               ? current_cap * Numerator / Denominator
+                               : SIZE_MAX;
+    return std::max(grown_cap, required);
+  }
+
+  static std::size_t fit_capacity(std::size_t required,
+                                  std::size_t /* element_size */) noexcept {
+    return required;
+  }
+};
+
+/** @brief Rounds the required capacity up to the next multiple of Step
+ *         elements. Growth is linear, so this should only be used when the
+ *         final size of the container is known to be small. */
+template <std::size_t Step = 1024> struct additive_growth {
+  static_assert(Step > 0, "the growth step can't be zero");
+
+  static std::size_t next_capacity(std::size_t /* current_cap */,
+                                   std::size_t required,
+                                   std::size_t /* element_size */) noexcept {
+    return ((required + Step - 1) / Step) * Step;
+  }
+
+  static std::size_t fit_capacity(std::size_t required,
+                                  std::size_t element_size) noexcept {
+    return next_capacity(0, required, element_size);
+  }
+};
+
+/** @brief Grows as BaseGrowth does, but then rounds the size of the memory
+ *         block up to a whole number of pages of PageSize bytes. */
+template <std::size_t PageSize = 4096, class BaseGrowth = geometric_growth<>>
+struct page_aligned_growth {
+  static_assert(PageSize > 0, "the page size can't be zero");
+
+  static std::size_t next_capacity(std::size_t current_cap,
+                                   std::size_t required,
+                                   std::size_t element_size) noexcept {
+    return round_to_pages(
+        BaseGrowth::next_capacity(current_cap, required, element_size),
+        element_size);
+  }
+
+  static std::size_t fit_capacity(std::size_t required,
+                                  std::size_t element_size) noexcept {
+    return round_to_pages(BaseGrowth::fit_capacity(required, element_size),
+                          element_size);
+  }
+
+private:
+  static std::size_t round_to_pages(std::size_t capacity,
+                                    std::size_t element_size) noexcept {
+    const auto bytes = capacity * element_size;
+    const auto page_bytes = ((bytes + PageSize - 1) / PageSize) * PageSize;
+    return std::max(capacity, page_bytes / element_size);
+  }
+};
+
+/** @brief Grows as BaseGrowth does, but then rounds the size of the memory
+ *         block up to a whole number of Width bytes SIMD registers. Combined
+ *         with storage aligned to Width bytes, every vector lane loaded from
+ *         the container falls within its memory block. */
+template <std::size_t Width = 64, class BaseGrowth = geometric_growth<>>
+using vector_width_growth = page_aligned_growth<Width, BaseGrowth>;
+
+/*
+ * *** ALLOCATION STATISTICS ***
+ *
+ * A statistics policy gets notified of the storage events of a container,
+ * which holds one instance of it. It must provide the member functions
+ *
+ *   void on_allocate(std::size_t capacity, std::size_t element_size);
+ *   void on_deallocate(std::size_t capacity, std::size_t element_size);
+ *   void on_relocate(std::size_t count);
+ *   void on_storage_change(std::size_t size, std::size_t capacity);
+ *
+ * on_relocate() reports the elements moved to a new block during a
+ * reallocation, and on_storage_change() gets called each time the container
+ * starts using a different block. None of them may throw, since they are
+ * also called from the noexcept move and swap operations. The default policy
+ * does nothing and takes no room in the container.
+ * */
+
+/** @brief Statistics policy that ignores every event. */
+struct no_stats {
+  void on_allocate(std::size_t /* capacity */,
+                   std::size_t /* element_size */) noexcept {}
+  void on_deallocate(std::size_t /* capacity */,
+                     std::size_t /* element_size */) noexcept {}
+  void on_relocate(std::size_t /* count */) noexcept {}
+  void on_storage_change(std::size_t /* size */,
+                         std::size_t /* capacity */) noexcept {}
+};
+
+/** @brief Storage counters, as reported by counting_stats. */
+struct allocation_counters {
+  std::size_t allocations;
+  std::size_t deallocations;
+  std::size_t bytes_requested;
+  std::size_t elements_relocated;
+  std::size_t peak_capacity;
+  std::size_t wasted_capacity;
+};
+
+/** @brief Statistics policy that counts the storage events of each container,
+ *         and aggregates them across all the containers using the same Tag.
+ *
+ * Using the element type as Tag gives per-type totals. The wasted capacity is
+ * the capacity not used by elements, as of the last storage change or the last
+ * call to the stats() member of the container, and its total is the sum over
+ * the live containers. Totals are kept in atomics, so containers in different
+ * threads can share a Tag. Copies of a container start with fresh counters. */
+template <class Tag = void> class counting_stats {
+public:
+  counting_stats() noexcept : counters_{} {}
+  counting_stats(const counting_stats &) noexcept : counting_stats() {}
+  counting_stats &operator=(const counting_stats &) noexcept { return *this; }
+
+  /** @brief Counters of this container. */
+  const allocation_counters &counters() const noexcept { return counters_; }
+
+  /** @brief Counters aggregated across all the containers using Tag. */
+  static allocation_counters totals() noexcept {
+    const auto &shared = shared_counters();
+    return allocation_counters{shared.allocations,
+                               shared.deallocations,
+                               shared.bytes_requested,
+                               shared.elements_relocated,
+                               shared.peak_capacity,
+                               shared.wasted_capacity};
+  }
+
+  /** @brief Zeroes the aggregated counters, except for the wasted capacity of
+   *         the live containers. */
+  static void reset_totals() noexcept {
+    auto &shared = shared_counters();
+    shared.allocations = 0;
+    shared.deallocations = 0;
+    shared.bytes_requested = 0;
+    shared.elements_relocated = 0;
+    shared.peak_capacity = 0;
+  }
+
+  void on_allocate(std::size_t capacity, std::size_t element_size) noexcept {
+    auto &shared = shared_counters();
+    ++counters_.allocations;
+    ++shared.allocations;
+    counters_.bytes_requested += capacity * element_size;
+    shared.bytes_requested += capacity * element_size;
+    counters_.peak_capacity = std::max(counters_.peak_capacity, capacity);
+    auto peak = shared.peak_capacity.load();
+    while ((peak < capacity) &&
+           !shared.peak_capacity.compare_exchange_weak(peak, capacity)) {
+    }
+  }
+
+  void on_deallocate(std::size_t /* capacity */,
+                     std::size_t /* element_size */) noexcept {
+    ++counters_.deallocations;
+    ++shared_counters().deallocations;
+  }
+
+  void on_relocate(std::size_t count) noexcept {
+    counters_.elements_relocated += count;
+    shared_counters().elements_relocated += count;
+  }
+
+  void on_storage_change(std::size_t size, std::size_t capacity) noexcept {
+    auto &shared = shared_counters();
+    shared.wasted_capacity -= counters_.wasted_capacity;
+    counters_.wasted_capacity = capacity - size;
+    shared.wasted_capacity += counters_.wasted_capacity;
+  }
+
+private:
+  struct atomic_counters {
+    std::atomic<std::size_t> allocations;
+    std::atomic<std::size_t> deallocations;
+    std::atomic<std::size_t> bytes_requested;
+    std::atomic<std::size_t> elements_relocated;
+    std::atomic<std::size_t> peak_capacity;
+    std::atomic<std::size_t> wasted_capacity;
+  };
+
+  static atomic_counters &shared_counters() noexcept {
+    /* zero-initialized, since it has static storage duration */
+    static atomic_counters instance;
+    return instance;
+  }
+
+  allocation_counters counters_;
+};
+
+/*
+ * *** ELEMENT STORAGE HELPERS ***
+ *
+ * Element management shared by the containers in this library. They all work
+ * on raw blocks of storage, constructing and destroying through the
+ * container's allocator.
+ * */
+
+namespace detail {
+
+template <class...> struct make_void { using type = void; };
+
+/** @brief Reports a failed EKUVECTOR_CHECK() and aborts. */
+[[noreturn]] inline void check_failed(const char *message, const char *file,
+                                      int line) noexcept {
+  std::fprintf(stderr, "%s:%d: %s\n", file, line, message);
+  std::abort();
+}
+
+/** @brief Returns the index of the highest bit set in value, or zero if there
+ *         is none. */
+constexpr std::size_t log2_floor(std::size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return value ? sizeof(unsigned long long) * CHAR_BIT - 1 -
+                     static_cast<std::size_t>(__builtin_clzll(value))
+               : 0;
+#else
+  std::size_t bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+/** @brief Removes the parallel overloads from the overload set unless Policy
+ *         is an execution policy. */
+template <class Policy>
+using enable_if_execution_policy = typename std::enable_if<
+    is_execution_policy<typename std::decay<Policy>::type>::value>::type;
+
+/** @brief Constructs an object at p through the allocator traits, so that
+ *         allocators without a construct() member get placement new. */
+template <class Allocator, class T, class... Args>
+void construct(Allocator &alloc, T *p, Args &&... args) {
+  std::allocator_traits<Allocator>::construct(alloc, p,
+                                              std::forward<Args>(args)...);
+}
+
+/** @brief Destroys the object at p through the allocator traits. */
+template <class Allocator, class T> void destroy(Allocator &alloc, T *p) {
+  std::allocator_traits<Allocator>::destroy(alloc, p);
+}
+
+/** @brief Returns the raw pointer held by a (possibly fancy) pointer. */
+template <class T> T *to_address(T *p) noexcept { return p; }
+
+template <class Ptr>
+typename std::pointer_traits<Ptr>::element_type *
+to_address(const Ptr &p) noexcept {
+  return to_address(p.operator->());
+}
+
+template <class Allocator, class T, class = void>
+struct has_construct_member : std::false_type {};
+
+template <class Allocator, class T>
+struct has_construct_member<
+    Allocator, T,
+    typename make_void<decltype(std::declval<Allocator &>().construct(
+        std::declval<T *>(), std::declval<T &&>()))>::type> : std::true_type {
+};
+
+template <class Allocator, class T, class = void>
+struct has_destroy_member : std::false_type {};
+
+template <class Allocator, class T>
+struct has_destroy_member<
+    Allocator, T,
+    typename make_void<decltype(std::declval<Allocator &>().destroy(
+        std::declval<T *>()))>::type> : std::true_type {};
+
+template <class Allocator> struct is_std_allocator : std::false_type {};
+
+template <class U>
+struct is_std_allocator<std::allocator<U>> : std::true_type {};
+
+/* The bulk element operations (memmove() relocation, memcpy() copies, fills,
+ * skipping trivial destructors) bypass the construct() and destroy() members
+ * of the allocator, so they are only used if it doesn't customize them */
+template <class Allocator, class T>
+using default_element_ops = std::integral_constant<
+    bool, is_std_allocator<Allocator>::value ||
+              (!has_construct_member<Allocator, T>::value &&
+               !has_destroy_member<Allocator, T>::value)>;
+
+/** @brief Replaces dst with src, if the propagation trait of the allocator
+ *         says so. */
+template <class Allocator, class Source>
+void propagate_allocator(Allocator &dst, Source &&src, std::true_type) {
+  dst = std::forward<Source>(src);
+}
+
+template <class Allocator, class Source>
+void propagate_allocator(Allocator & /* dst */, Source && /* src */,
+                         std::false_type) {}
+
+/** @brief Exchanges lhs and rhs, if the propagation trait of the allocator
+ *         says so. */
+template <class Allocator>
+void swap_allocators(Allocator &lhs, Allocator &rhs, std::true_type) {
+  using std::swap;
+  swap(lhs, rhs);
+}
+
+template <class Allocator>
+void swap_allocators(Allocator & /* lhs */, Allocator & /* rhs */,
+                     std::false_type) {}
+
+/* storage can only be handed over on move assignment, which doesn't allocate,
+   if the allocator propagates or all of its instances compare equal */
+template <class Allocator>
+using nothrow_move_assignment = std::integral_constant<
+    bool, std::allocator_traits<
+              Allocator>::propagate_on_container_move_assignment::value ||
+              std::allocator_traits<Allocator>::is_always_equal::value>;
+
+template <class Allocator, class T>
+using relocation_tag =
+    std::integral_constant<bool, is_trivially_relocatable<T>::value &&
+                                     default_element_ops<Allocator, T>::value>;
+
+template <class Allocator, class Enable = void>
+struct has_reallocate_member : std::false_type {};
+
+template <class Allocator>
+struct has_reallocate_member<
+    Allocator,
+    typename make_void<decltype(std::declval<Allocator &>().reallocate(
+        std::declval<typename std::allocator_traits<Allocator>::pointer>(),
+        std::size_t{}, std::size_t{}))>::type> : std::true_type {};
+
+/* Allocators may provide a member
+ *
+ *   pointer reallocate(pointer block, std::size_t old_n, std::size_t new_n);
+ *
+ * which resizes a live block keeping its contents, as realloc() or mremap()
+ * do, possibly moving it. It's used instead of allocating a new block and
+ * relocating the elements into it, only if they can be relocated bytewise */
+template <class Allocator, class T>
+using block_resize_tag =
+    std::integral_constant<bool, has_reallocate_member<Allocator>::value &&
+                                     relocation_tag<Allocator, T>::value>;
+
+template <class Allocator, class T>
+void relocate_forward(Allocator & /* alloc */, T *dst, T *src,
+                      std::size_t count, std::true_type) {
+  if (count) {
+    std::memmove(static_cast<void *>(dst), static_cast<const void *>(src),
+                 count * sizeof(T));
+  }
+}
+
+template <class Allocator, class T>
+void relocate_forward(Allocator &alloc, T *dst, T *src, std::size_t count,
+                      std::false_type) {
+  for (std::size_t index = 0; index < count; ++index) {
+    detail::construct(alloc, dst + index, std::move(*(src + index)));
+    detail::destroy(alloc, src + index); // destruct residual object
+  }
+}
+
+/** @brief Relocates count elements from src to the uninitialized storage at
+ *         dst, leaving the source range uninitialized.
+ *
+ * Ranges are processed front to back, so they may only overlap if dst comes
+ * before src. Trivially relocatable types are moved with a single memmove().
+ * */
+template <class Allocator, class T>
+void relocate_forward(Allocator &alloc, T *dst, T *src, std::size_t count) {
+  relocate_forward(alloc, dst, src, count, relocation_tag<Allocator, T>{});
+}
+
+template <class Allocator, class T>
+void relocate_backward(Allocator &alloc, T *dst, T *src, std::size_t count,
+                       std::true_type) {
+  /* memmove() handles overlapping ranges in either direction */
+  relocate_forward(alloc, dst, src, count, std::true_type{});
+}
+
+template <class Allocator, class T>
+void relocate_backward(Allocator &alloc, T *dst, T *src, std::size_t count,
+                       std::false_type) {
+  while (count) {
+    --count;
+    detail::construct(alloc, dst + count, std::move(*(src + count)));
+    detail::destroy(alloc, src + count); // destruct residual object
+  }
+}
+
+/** @brief Same as relocate_forward(), but the ranges are processed back to
+ *         front, so they may only overlap if dst comes after src. */
+template <class Allocator, class T>
+void relocate_backward(Allocator &alloc, T *dst, T *src, std::size_t count) {
+  relocate_backward(alloc, dst, src, count, relocation_tag<Allocator, T>{});
+}
+
+/* Tails are only relocated within their block to open a gap for several
+ * elements if that can't throw, as a move failing half way would leave a
+ * hole among the live elements that can't be closed again */
+template <class Allocator, class T>
+using gap_relocation_tag = std::integral_constant<
+    bool, relocation_tag<Allocator, T>::value ||
+              std::is_nothrow_move_constructible<T>::value>;
+
+template <class Allocator, class T>
+void destroy_range(Allocator & /* alloc */, T * /* first */, T * /* last */,
+                   std::true_type) noexcept {
+  /* nothing to do, trivially destructible objects just cease to exist */
+}
+
+template <class Allocator, class T>
+void destroy_range(Allocator &alloc, T *first, T *last,
+                   std::false_type) noexcept {
+  for (; first != last; ++first) {
+    detail::destroy(alloc, first);
+  }
+}
+
+/** @brief Destroys the elements in [first, last). This is a no-op for
+ *         trivially destructible types. */
+template <class Allocator, class T>
+void destroy_range(Allocator &alloc, T *first, T *last) noexcept {
+  destroy_range(alloc, first, last,
+                std::integral_constant<
+                    bool, std::is_trivially_destructible<T>::value &&
+                              default_element_ops<Allocator, T>::value>{});
+}
+
+template <class Allocator, class T>
+void relocate_around(Allocator &alloc, T *dst, T *src, std::size_t ordinal,
+                     std::size_t gap, std::size_t count, std::true_type) {
+  relocate_forward(alloc, dst, src, ordinal, std::true_type{});
+  relocate_forward(alloc, dst + ordinal + gap, src + ordinal, count - ordinal,
+                   std::true_type{});
+}
+
+template <class Allocator, class T>
+void relocate_around(Allocator &alloc, T *dst, T *src, std::size_t ordinal,
+                     std::size_t gap, std::size_t count, std::false_type) {
+  /* elements are moved if that can't throw, and copied otherwise, so the
+     source stays intact until all of them made it to the new block */
+  std::size_t index = 0;
+  try {
+    for (; index < count; ++index) {
+      const auto offset = (index < ordinal) ? index : index + gap;
+      detail::construct(alloc, dst + offset, std::move_if_noexcept(src[index]));
+    }
+  } catch (...) {
+    destroy_range(alloc, dst, dst + std::min(index, ordinal));
+    if (index > ordinal) {
+      destroy_range(alloc, dst + ordinal + gap, dst + index + gap);
+    }
+    throw;
+  }
+  destroy_range(alloc, src, src + count);
+}
+
+/** @brief Relocates count elements from src to the uninitialized storage of
+ *         another block at dst, leaving a gap of gap slots before the element
+ *         at ordinal.
+ *
+ * This gives the strong exception guarantee: elements that may throw while
+ * being moved but can be copied are copied instead, and if anything throws
+ * the source range is left untouched and dst is left uninitialized. */
+template <class Allocator, class T>
+void relocate_around(Allocator &alloc, T *dst, T *src, std::size_t ordinal,
+                     std::size_t gap, std::size_t count) {
+  relocate_around(alloc, dst, src, ordinal, gap, count,
+                  relocation_tag<Allocator, T>{});
+}
+
+template <class Allocator, class T, class Value>
+void shift_insert(Allocator &alloc, T *pos, T *end, Value &&value,
+                  std::true_type) {
+  /* open a gap at pos with a single memmove(), and build the value in it */
+  const auto tail_size = static_cast<std::size_t>(end - pos);
+  relocate_backward(alloc, pos + 1, pos, tail_size, std::true_type{});
+  try {
+    detail::construct(alloc, pos, std::forward<Value>(value));
+  } catch (...) {
+    relocate_forward(alloc, pos, pos + 1, tail_size, std::true_type{});
+    throw;
+  }
+}
+
+template <class Allocator, class T, class Value>
+void shift_insert(Allocator &alloc, T *pos, T *end, Value &&value,
+                  std::false_type) {
+  /* the last element is moved to the uninitialized slot past the end, and
+     the rest of the tail is shifted one slot by move-assignment */
+  detail::construct(alloc, end, std::move(*(end - 1)));
+  std::move_backward(pos, end - 1, end);
+  *pos = std::forward<Value>(value);
+}
+
+/** @brief Inserts value at pos, shifting [pos, end) one slot towards the end.
+ *
+ * pos must come before end, and there must be storage for one more element
+ * past end. */
+template <class Allocator, class T, class Value>
+void shift_insert(Allocator &alloc, T *pos, T *end, Value &&value) {
+  shift_insert(alloc, pos, end, std::forward<Value>(value),
+               relocation_tag<Allocator, T>{});
+}
+
+template <class Allocator, class T>
+T *erase_range(Allocator &alloc, T *first, T *last, T *end, std::true_type) {
+  /* destroy the erased elements, and then slide the tail over the gap */
+  destroy_range(alloc, first, last);
+  const auto tail_size = static_cast<std::size_t>(end - last);
+  relocate_forward(alloc, first, last, tail_size, std::true_type{});
+  return first + tail_size;
+}
+
+template <class Allocator, class T>
+T *erase_range(Allocator &alloc, T *first, T *last, T *end, std::false_type) {
+  /* move-assign the tail over the erased elements, then destroy the
+     leftovers at the end */
+  auto new_end = std::move(last, end, first);
+  destroy_range(alloc, new_end, end);
+  return new_end;
+}
+
+/** @brief Removes the elements in [first, last) from the range that ends at
+ *         end, closing the gap. Returns the new end of the range. */
+template <class Allocator, class T>
+T *erase_range(Allocator &alloc, T *first, T *last, T *end) {
+  return erase_range(alloc, first, last, end, relocation_tag<Allocator, T>{});
+}
+
+/* Copies from InputIt to T storage can be done with a single memcpy() when
+ * the source is a plain pointer to trivially copyable elements of type T */
+template <class InputIt, class T>
+using bulk_copy_tag = std::integral_constant<
+    bool, std::is_trivially_copyable<T>::value &&
+              std::is_pointer<InputIt>::value &&
+              std::is_same<typename std::remove_cv<typename std::remove_pointer<
+                               InputIt>::type>::type,
+                           T>::value>;
+
+template <class InputIt, class T>
+InputIt copy_assign_n(InputIt first, std::size_t count, T *dst,
+                      std::true_type) {
+  if (count) {
+    std::memcpy(static_cast<void *>(dst), static_cast<const void *>(first),
+                count * sizeof(T));
+  }
+  return first + count;
+}
+
+template <class InputIt, class T>
+InputIt copy_assign_n(InputIt first, std::size_t count, T *dst,
+                      std::false_type) {
+  for (std::size_t index = 0; index < count; ++index, ++first) {
+    *(dst + index) = *first;
+  }
+  return first;
+}
+
+/** @brief Copy-assigns count elements read from first over the live elements
+ *         at dst. Returns the iterator past the last element read. */
+template <class InputIt, class T>
+InputIt copy_assign_n(InputIt first, std::size_t count, T *dst) {
+  return copy_assign_n(first, count, dst, bulk_copy_tag<InputIt, T>{});
+}
+
+template <class Allocator, class InputIt, class T>
+InputIt copy_construct_n(Allocator & /* alloc */, InputIt first,
+                         std::size_t count, T *dst, std::true_type) {
+  return copy_assign_n(first, count, dst, std::true_type{});
+}
+
+template <class Allocator, class InputIt, class T>
+InputIt copy_construct_n(Allocator &alloc, InputIt first, std::size_t count,
+                         T *dst, std::false_type) {
+  std::size_t index = 0;
+  try {
+    for (; index < count; ++index, ++first) {
+      detail::construct(alloc, dst + index, *first);
+    }
+  } catch (...) {
+    destroy_range(alloc, dst, dst + index);
+    throw;
+  }
+  return first;
+}
+
+/** @brief Copy-constructs count elements read from first into the
+ *         uninitialized storage at dst. Returns the iterator past the last
+ *         element read.
+ *
+ * If a constructor throws, the elements constructed so far are destroyed
+ * before rethrowing. */
+template <class Allocator, class InputIt, class T>
+InputIt copy_construct_n(Allocator &alloc, InputIt first, std::size_t count,
+                         T *dst) {
+  return copy_construct_n(
+      alloc, first, count, dst,
+      std::integral_constant<bool,
+                             bulk_copy_tag<InputIt, T>::value &&
+                                 default_element_ops<Allocator, T>::value>{});
+}
+
+/** @brief Copy-constructs count copies of value into the uninitialized
+ *         storage at dst.
+ *
+ * If a constructor throws, the elements constructed so far are destroyed
+ * before rethrowing. */
+template <class Allocator, class T>
+void fill_construct_n(Allocator &alloc, T *dst, std::size_t count,
+                      const T &value) {
+  std::size_t index = 0;
+  try {
+    for (; index < count; ++index) {
+      detail::construct(alloc, dst + index, value);
+    }
+  } catch (...) {
+    destroy_range(alloc, dst, dst + index);
+    throw;
+  }
+}
+
+template <class ForwardIt, class T>
+bool range_aliases(ForwardIt first, const T *data, std::size_t count,
+                   std::true_type) noexcept {
+  const auto address = std::addressof(*first);
+  return !std::less<const T *>{}(address, data) &&
+         std::less<const T *>{}(address, data + count);
+}
+
+template <class ForwardIt, class T>
+bool range_aliases(ForwardIt /* first */, const T * /* data */,
+                   std::size_t /* count */, std::false_type) noexcept {
+  return false;
+}
+
+/** @brief Returns whether the non-empty range that starts at first reads the
+ *         elements in [data, data + count), which only iterators that yield
+ *         references to T can do. */
+template <class ForwardIt, class T>
+bool range_aliases(ForwardIt first, const T *data, std::size_t count) noexcept {
+  using reference = typename std::iterator_traits<ForwardIt>::reference;
+  return range_aliases(
+      first, data, count,
+      std::integral_constant<
+          bool, std::is_lvalue_reference<reference>::value &&
+                    std::is_same<typename std::decay<reference>::type,
+                                 T>::value>{});
+}
+
+template <class Allocator, class T>
+void value_construct_n(Allocator & /* alloc */, T *dst, std::size_t count,
+                       std::true_type) {
+  /* value-initialized trivial objects are all copies of T() */
+  std::fill_n(dst, count, T());
+}
+
+template <class Allocator, class T>
+void value_construct_n(Allocator &alloc, T *dst, std::size_t count,
+                       std::false_type) {
+  std::size_t index = 0;
+  try {
+    for (; index < count; ++index) {
+      detail::construct(alloc, dst + index);
+    }
+  } catch (...) {
+    destroy_range(alloc, dst, dst + index);
+    throw;
+  }
+}
+
+/** @brief Value-initializes count elements in the uninitialized storage at
+ *         dst. Trivial types are filled in bulk.
+ *
+ * If a constructor throws, the elements constructed so far are destroyed
+ * before rethrowing. */
+template <class Allocator, class T>
+void value_construct_n(Allocator &alloc, T *dst, std::size_t count) {
+  value_construct_n(
+      alloc, dst, count,
+      std::integral_constant<bool,
+                             std::is_trivial<T>::value &&
+                                 default_element_ops<Allocator, T>::value>{});
+}
+
+template <class Allocator, class T>
+void default_construct_n(Allocator & /* alloc */, T * /* dst */,
+                         std::size_t /* count */, std::true_type) {
+  /* nothing to do, trivial objects are left uninitialized */
+}
+
+template <class Allocator, class T>
+void default_construct_n(Allocator &alloc, T *dst, std::size_t count,
+                         std::false_type) {
+  std::size_t index = 0;
+  try {
+    for (; index < count; ++index) {
+      ::new (static_cast<void *>(dst + index)) T;
+    }
+  } catch (...) {
+    destroy_range(alloc, dst, dst + index);
+    throw;
+  }
+}
+
+/** @brief Default-initializes count elements in the uninitialized storage at
+ *         dst, which leaves trivially default constructible types with
+ *         indeterminate values.
+ *
+ * The allocator has no way to default-initialize objects, so the elements are
+ * built with placement new. If a constructor throws, the elements constructed
+ * so far are destroyed before rethrowing. */
+template <class Allocator, class T>
+void default_construct_n(Allocator &alloc, T *dst, std::size_t count) {
+  default_construct_n(alloc, dst, count,
+                      std::is_trivially_default_constructible<T>{});
+}
+
+} // namespace detail
+
+template <class Type, class Allocator = std::allocator<Type>,
+          class Growth = geometric_growth<>, class Stats = no_stats>
+class ekuvector : private Stats {
 public:
   using type = Type;
   using reference = Type &;
@@ -33,21 +844,41 @@ public:
   using difference_type = std::ptrdiff_t;
   using value_type = Type;
   using allocator_type = Allocator;
-
-  using pointer = Type *;
-  using const_pointer = const Type *;
-
-  using iterator = pointer;
-  using const_iterator = const_pointer;
+  using growth_policy = Growth;
+  using stats_policy = Stats;
+
+  using pointer = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer =
+      typename std::allocator_traits<Allocator>::const_pointer;
+
+#if defined(EKUVECTOR_CHECKED)
+  template <bool Const> class checked_iterator;
+
+  using iterator = checked_iterator<false>;
+  using const_iterator = checked_iterator<true>;
+#else
+  using iterator = Type *;
+  using const_iterator = const Type *;
+#endif
   using reverse_iterator = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+  /** @brief Memory block handed over by release(). Its first size elements
+   *         are alive, and it must be returned to allocator with room for
+   *         capacity elements. */
+  struct released_block {
+    pointer data;
+    size_type size;
+    size_type capacity;
+    allocator_type allocator;
+  };
+
   /** @brief Default constructor. Constructs an empty container with a
    *         default-constructed allocator_. */
-  ekuvector();
+  ekuvector() noexcept(noexcept(Allocator()));
 
   /** @brief Constructs an empty container with the given allocator alloc. */
-  explicit ekuvector(const Allocator &alloc);
+  explicit ekuvector(const Allocator &alloc) noexcept;
 
   /** @brief Constructs the container with count default-inserted instances of
    *         Type. No copies are made. */
@@ -83,22 +914,47 @@ public:
    *
    * Constructs the container with the contents of other using move semantics.
    * Allocator is obtained by move-construction from the allocator belonging to
-   * other. After the move, other is guaranteed to be empty(). */
-  ekuvector(ekuvector &&other);
+   * other. After the move, other is guaranteed to be empty(). Never throws,
+   * which lets containers of ekuvector relocate them by moving. */
+  ekuvector(ekuvector &&other) noexcept;
 
   /** @brief Allocator-extended move constructor.
    *
    * Using alloc as the allocator for the new container, moving the contents
    * from other; if alloc != other.get_allocator(), this results in an
    * element-wise move. (in that case, other is not guaranteed to be empty after
-   * the move) */
-  ekuvector(ekuvector &&other, const Allocator &alloc);
+   * the move). Never throws if all instances of the allocator compare equal.
+   * */
+  ekuvector(ekuvector &&other, const Allocator &alloc) noexcept(
+      std::allocator_traits<Allocator>::is_always_equal::value);
 
   /** @brief Constructs the container with the contents of the initializer list
    *         init.  */
   ekuvector(std::initializer_list<Type> init,
             const Allocator &alloc = Allocator());
 
+  /** @brief Constructs the container with count copies of value, splitting
+   *         the work across the threads of policy.
+   *
+   * Every chunk is constructed by the thread that takes it, which also makes
+   * it the first one to touch the pages of a freshly mapped block, so that
+   * they land on the NUMA node of that thread. The allocator gets called from
+   * several threads at once. */
+  template <class ExecutionPolicy,
+            class = detail::enable_if_execution_policy<ExecutionPolicy>>
+  ekuvector(ExecutionPolicy &&policy, size_type count, const Type &value,
+            const Allocator &alloc = Allocator());
+
+  /** @brief Copy constructor splitting the work across the threads of policy.
+   *         Same as the serial overloads otherwise. */
+  template <class ExecutionPolicy,
+            class = detail::enable_if_execution_policy<ExecutionPolicy>>
+  ekuvector(ExecutionPolicy &&policy, const ekuvector &other);
+  template <class ExecutionPolicy,
+            class = detail::enable_if_execution_policy<ExecutionPolicy>>
+  ekuvector(ExecutionPolicy &&policy, const ekuvector &other,
+            const Allocator &alloc);
+
   /** @brief Destructor. */
   ~ekuvector();
 
@@ -125,8 +981,10 @@ public:
    * must move-assign each element individually, allocating additional memory
    * using its own allocator as needed. In any case, all elements originally
    * present in *this are either destroyed or replaced by elementwise
-   * move-assignment. */
-  ekuvector &operator=(ekuvector &&other);
+   * move-assignment. Never throws if the allocator propagates or all of its
+   * instances compare equal. */
+  ekuvector &operator=(ekuvector &&other) noexcept(
+      detail::nothrow_move_assignment<Allocator>::value);
 
   /** @brief Replaces the contents with those identified by initializer list
    *         ilist. */
@@ -150,6 +1008,16 @@ public:
    *         ilist. */
   void assign(std::initializer_list<Type> ilist);
 
+  /** @brief Replaces the contents with count copies of value, splitting the
+   *         work across the threads of policy.
+   *
+   * Unlike the serial overload, the old elements are all destroyed and the
+   * new ones are copy-constructed, instead of being assigned over the old
+   * ones. If a constructor throws, the container is left empty. */
+  template <class ExecutionPolicy,
+            class = detail::enable_if_execution_policy<ExecutionPolicy>>
+  void assign(ExecutionPolicy &&policy, size_type count, const Type &value);
+
   /** @brief Returns the allocator associated with the container. */
   allocator_type get_allocator() const;
 
@@ -236,24 +1104,45 @@ public:
    *         equal to new_cap.
    *
    * If new_cap is greater than the current capacity(), new storage is
-   * allocated, otherwise the method does nothing. reserve() does not change the
-   * size of the ekuvector. If new_cap is greater than capacity(), all
+   * allocated, otherwise the method does nothing. The new capacity is rounded
+   * as the growth policy does for shrink_to_fit(). reserve() does not change
+   * the size of the ekuvector. If new_cap is greater than capacity(), all
    * iterators,
    * including the past-the-end iterator, and all references to the elements are
    * invalidated. Otherwise, no iterators or references are invalidated. */
   void reserve(size_type new_cap);
 
+  /** @brief The same as reserve(), but allocating room for exactly new_cap
+   *         elements, with no rounding by the growth policy.
+   *
+   * Meant for buffers whose final size is known upfront, which won't grow any
+   * further. */
+  void reserve_exact(size_type new_cap);
+
+  /** @brief The same as reserve(), but reporting failure to allocate the new
+   *         storage or to relocate the elements into it by returning false
+   *         instead of throwing. The container is left untouched on
+   *         failure. */
+  bool try_reserve(size_type new_cap) noexcept;
+
+  /** @brief Returns the capacity the container would grow to if it had to
+   *         make room for required elements, as decided by the growth policy
+   *         from the current capacity. Returns capacity() if required
+   *         elements already fit. Nothing is allocated. */
+  size_type next_capacity(size_type required) const noexcept;
+
   /** @brief Returns the number of elements that the container has currently
    * allocated space for. */
   size_type capacity() const noexcept;
 
   /** @brief Requests the removal of unused capacity.
    *
-   * It is a non-binding request to reduce capacity() to size(). It depends on
-   * the implementation whether the request is fulfilled. If reallocation
-   * occurs, all iterators, including the past the end iterator, and all
-   * references to the elements are invalidated. If no reallocation takes place,
-   * no iterators or references are invalidated. */
+   * Reduces capacity() to size(), or to the smallest capacity the growth
+   * policy allows for size() elements. An empty container releases its
+   * storage altogether. If reallocation occurs, all iterators, including the
+   * past the end iterator, and all references to the elements are
+   * invalidated. If no reallocation takes place, no iterators or references
+   * are invalidated. */
   void shrink_to_fit();
 
   /** @brief Erases all elements from the container. After this call, size()
@@ -266,6 +1155,12 @@ public:
    * changes to capacity is in the specification of ekuvector::reserve)  */
   void clear() noexcept;
 
+  /** @brief Erases all elements from the container, running the destructors
+   *         across the threads of policy. */
+  template <class ExecutionPolicy,
+            class = detail::enable_if_execution_policy<ExecutionPolicy>>
+  void clear(ExecutionPolicy &&policy) noexcept;
+
   /** @brief Inserts value before pos */
   iterator insert(const_iterator pos, const Type &value);
   iterator insert(const_iterator pos, Type &&value);
@@ -317,6 +1212,25 @@ public:
    * if first==last: erasing an empty range is a no-op. */
   iterator erase(const_iterator first, const_iterator last);
 
+  /** @brief Erases the element at pos in O(1), without keeping the order of
+   *         the remaining elements.
+   *
+   * The last element is moved into the place of the erased one, and then
+   * removed. Returns an iterator to pos, which refers to the element that used
+   * to be the last one, or is end() if pos was the last element. References
+   * and iterators to pos and to the last element, as well as the end()
+   * iterator, are invalidated. */
+  iterator erase_unordered(const_iterator pos);
+
+  /** @brief Erases every element for which pred returns true, and returns the
+   *         number of erased elements.
+   *
+   * The container is compacted in a single pass, keeping the order of the
+   * surviving elements. Each survivor placed after an erased element gets
+   * moved once, and the leftover tail is destroyed in bulk. Iterators and
+   * references at or after the first erased element are invalidated. */
+  template <class Predicate> size_type erase_if(Predicate pred);
+
   /** @brief Appends the given element value to the end of the container.
  *
  * The new element is initialized as a copy of value. If the new size() is
@@ -344,6 +1258,38 @@ public:
    * iterator is invalidated.  */
   template <class... Args> void emplace_back(Args &&... args);
 
+  /** @brief Appends a new element to the end of the container, which must
+   *         have room for it.
+   *
+   * Works as emplace_back(), but skips the capacity check, so it's meant for
+   * filling storage previously set up with reserve(). The behavior is undefined
+   * if size() is not less than capacity(). Only the past-the-end iterator is
+   * invalidated. */
+  template <class... Args> void unchecked_emplace_back(Args &&... args);
+
+  /** @brief Appends copies of the elements in the range [first, last) to the
+   *         end of the container.
+   *
+   * This overload only participates in overload resolution if InputIt
+   * qualifies as LegacyInputIterator. Unless InputIt is only an input
+   * iterator, the capacity is checked once for the whole range, and the new
+   * elements are constructed in bulk. If the new size() is greater than
+   * capacity() then all iterators and references (including the past-the-end
+   * iterator) are invalidated. Otherwise only the past-the-end iterator is
+   * invalidated. */
+  template <class InputIt>
+  void append(
+      InputIt first,
+      typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last);
+
+  /** @brief Appends count elements to the end of the container, each one
+   *         constructed from the value returned by a call to generator().
+   *
+   * The capacity is checked once for the whole batch. If generator() or a
+   * constructor throws, the elements appended so far are removed again.
+   * Iterators are invalidated as for append(first, last). */
+  template <class Generator> void append(size_type count, Generator generator);
+
   /** @brief Removes the last element of the container.
    *
    * Calling pop_back on an empty container is undefined. Iterators and
@@ -368,100 +1314,234 @@ public:
    * size is less than count, additional copies of value are appended */
   void resize(size_type count, const value_type &value);
 
+  /** @brief Resizes the container to contain count elements, leaving the
+   *         appended elements default-initialized.
+   *
+   * Same as resize(count), but for trivially default constructible types the
+   * new elements are not initialized at all. Meant for buffers that are about
+   * to be overwritten, such as the target of a read(). */
+  void resize_default_init(size_type count);
+
   /** @brief Exchanges the contents of the container with those of other.
    *
    * Does not invoke any move, copy, or swap operations on individual elements.
    * All iterators and references remain valid. The past-the-end iterator is
-   * invalidated. */
-  void swap(ekuvector &other);
+   * invalidated. Never throws. */
+  void swap(ekuvector &other) noexcept;
+
+  /** @brief Hands the memory block over to the caller, who becomes in charge
+   *         of destroying the elements and deallocating it. The container is
+   *         left empty, with no capacity. */
+  released_block release() noexcept;
+
+  /** @brief Takes ownership of a block with room for capacity elements, the
+   *         first size of which must be alive, replacing the contents of the
+   *         container.
+   *
+   * The block must have been allocated by an allocator that compares equal to
+   * get_allocator(), such as the one of a released_block, and it's eventually
+   * deallocated through it. No element is copied or moved. */
+  void adopt(pointer data, size_type size, size_type capacity) noexcept;
+
+  /** @brief Returns the statistics policy instance of the container, which
+   *         holds whatever it has gathered about its storage.
+   *
+   * The policy gets a storage change notification first, so that anything
+   * derived from the current size is up to date. */
+  const Stats &stats() noexcept;
 
 private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
   Allocator allocator_;
   size_t capacity_;
   size_t size_;
   pointer data_;
-
+#if defined(EKUVECTOR_CHECKED)
+  /* bumped every time the elements move to another block */
+  size_type generation_ = 0;
+#endif
+
+  /** @brief Returns the raw address of the storage held by data_, which may
+   *         be a fancy pointer. */
+  Type *raw_data() const noexcept;
+
+  /** @brief Marks every iterator into the container as invalid. Called each
+   *         time data_ changes. */
+  void invalidate_iterators() noexcept;
+
+  /** @brief Iterators to the element at address, which must be in the
+   *         storage of the container or one past its end. */
+  iterator make_iterator(Type *address) noexcept;
+  const_iterator make_iterator(const Type *address) const noexcept;
+
+  /** @brief Returns the ordinal of the element pos refers to, checking that
+   *         pos is a valid iterator into the container. */
+  size_type ordinal_of(const_iterator pos) const noexcept;
+
+  /** @brief Returns the capacity to grow to in order to make room for
+   *         required elements. Every growing path goes through here, so that
+   *         next_capacity() can report what growth will actually do. */
+  size_type grown_capacity(size_type required) const noexcept;
+
+  /** @brief Makes sure there's room for at least new_cap elements, growing the
+   *         storage as dictated by the growth policy. */
   void preallocate_capacity(size_type new_cap);
+
+  /** @brief Constructs count elements past the end using policy, calling
+   *         construct(dst, first, count) for each chunk of ordinals, and then
+   *         adds them to the size. On failure nothing is added. */
+  template <class ExecutionPolicy, class Construct>
+  void parallel_construct(ExecutionPolicy &policy, size_type count,
+                          Construct construct);
+
+  /** @brief Allocates and releases blocks of storage, keeping the statistics
+   *         policy informed. */
+  pointer allocate_block(size_type capacity);
+  void deallocate_block(pointer block, size_type capacity) noexcept;
+
+  /** @brief Moves the contents to a new block with room for exactly new_cap
+   *         elements, which must not be less than size(). A new_cap of zero
+   *         releases the storage. */
+  void reallocate(size_type new_cap);
+
+  /** @brief Resizes the block to new_cap through the reallocate() member of
+   *         the allocator, if there's a block and the allocator supports it.
+   *         Returns false if the block must be replaced by hand instead. */
+  bool resize_block(size_type new_cap);
+  bool resize_block(size_type new_cap, std::true_type);
+  bool resize_block(size_type new_cap, std::false_type) noexcept;
+
+  /** @brief The same as realloc_emplace(), but growing the block with
+   *         resize_block(). Returns false, leaving args untouched, if the
+   *         block must be replaced by hand instead. */
+  template <class... Args>
+  bool resize_emplace(size_type new_cap, size_type ordinal, std::true_type,
+                      Args &&... args);
+  template <class... Args>
+  bool resize_emplace(size_type new_cap, size_type ordinal, std::false_type,
+                      Args &&... args) noexcept;
+
+  /** @brief The same as the growing path of insert_range(), but growing the
+   *         block with resize_block(). Does not update size_. Returns false if
+   *         the block must be replaced by hand instead. */
+  template <class ForwardIt>
+  bool resize_insert(size_type new_cap, size_type ordinal, ForwardIt first,
+                     size_type count, std::true_type);
+  template <class ForwardIt>
+  bool resize_insert(size_type new_cap, size_type ordinal, ForwardIt first,
+                     size_type count, std::false_type) noexcept;
+
+  /** @brief Moves the contents to a new, larger block, constructing a new
+   *         element from args at ordinal inside the new block along the way.
+   * */
+  template <class... Args>
+  EKUVECTOR_NOINLINE void realloc_emplace(size_type ordinal, Args &&... args);
+
+  /** @brief Moves the contents to a new block with room for exactly new_cap
+   *         elements, constructing count copies of value at ordinal inside
+   *         the new block along the way. value must not be an element of the
+   *         container. */
+  EKUVECTOR_NOINLINE void realloc_fill(size_type new_cap, size_type ordinal,
+                                       size_type count, const Type &value);
+
+  /** @brief Replaces the contents with count elements read from first.
+   *
+   * Live elements are copy-assigned over, and only the missing ones are
+   * constructed or the surplus ones destroyed. The storage is only replaced
+   * if count exceeds the capacity. */
+  template <class ForwardIt> void assign_n(ForwardIt first, size_type count);
+
+  /** @brief Replaces the contents with the range [first, last).
+   *
+   * Single-pass ranges are appended one element at a time. Ranges that can be
+   * traversed more than once get measured first, so that the storage is
+   * allocated only once and with the exact size needed. */
+  template <class InputIt>
+  void assign_range(InputIt first, InputIt last, std::input_iterator_tag);
+  template <class ForwardIt>
+  void assign_range(ForwardIt first, ForwardIt last,
+                    std::forward_iterator_tag);
+
+  /** @brief Inserts the range [first, last) before the element at ordinal.
+   *
+   * The same as with assign_range(), only multi-pass ranges are measured
+   * upfront. Single-pass ranges are appended to the end and then rotated into
+   * place. */
+  template <class InputIt>
+  void insert_range(size_type ordinal, InputIt first, InputIt last,
+                    std::input_iterator_tag);
+  template <class ForwardIt>
+  void insert_range(size_type ordinal, ForwardIt first, ForwardIt last,
+                    std::forward_iterator_tag);
 };
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector() : ekuvector(Allocator()) {}
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector() noexcept(
+    noexcept(Allocator()))
+    : ekuvector(Allocator()) {}
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(const Allocator &alloc)
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(
+    const Allocator &alloc) noexcept
     : allocator_{alloc}, capacity_{0}, size_{0}, data_{nullptr} {}
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(size_type count, const Type &value,
-                                      const Allocator &alloc)
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(size_type count,
+                                                     const Type &value,
+                                                     const Allocator &alloc)
     : ekuvector(alloc) {
-  if (count) {
-    /* preallocate memory space for count elements */
-    preallocate_capacity(count);
-    /* call a copy constructor on each */
-    while (size_ < count) {
-      emplace_back(value);
-    }
-  }
+  resize(count, value);
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(size_type count) : ekuvector() {
-  if (count) {
-    /* preallocate memory space for count elements */
-    preallocate_capacity(count);
-    /* call a default constructor on each new item */
-    while (size_ < count) {
-      emplace_back();
-    }
-  }
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(size_type count)
+    : ekuvector() {
+  resize(count);
 }
 
-template <class Type, class Allocator>
+template <class Type, class Allocator, class Growth, class Stats>
 template <class InputIt>
-ekuvector<Type, Allocator>::ekuvector(
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(
     InputIt first,
     typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last,
     const Allocator &alloc)
     : ekuvector(alloc) {
-  for (auto it = first; it != last; ++it) {
-    push_back(*it);
-  }
+  assign_range(first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(const ekuvector &other)
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(const ekuvector &other)
     : ekuvector(other, std::allocator_traits<allocator_type>::
                            select_on_container_copy_construction(
                                other.get_allocator())) {}
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(const ekuvector &other,
-                                      const Allocator &alloc)
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(const ekuvector &other,
+                                                     const Allocator &alloc)
     : ekuvector(alloc) {
-  /* preallocate memory space for count elements */
-  preallocate_capacity(other.size());
-  /* call a copy constructor on each item of the original vector*/
-  while (size_ < other.size()) {
-    emplace_back(other[size_]);
-  }
+  assign_n(other.raw_data(), other.size_);
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(ekuvector &&other) {
-  /* move ownership of the contents to destination */
-  allocator_ = other.allocator_;
-  capacity_ = other.capacity_;
-  size_ = other.size_;
-  data_ = other.data_;
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(
+    ekuvector &&other) noexcept
+    : allocator_{std::move(other.allocator_)}, capacity_{other.capacity_},
+      size_{other.size_}, data_{other.data_} {
   /* empty source object, leaving in a safe state */
   other.size_ = 0;
   other.capacity_ = 0;
   other.data_ = nullptr;
+  other.invalidate_iterators();
+  Stats::on_storage_change(size_, capacity_);
+  other.on_storage_change(0, 0);
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(ekuvector &&other, const Allocator &alloc)
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(
+    ekuvector &&other, const Allocator &alloc) noexcept(
+    std::allocator_traits<Allocator>::is_always_equal::value)
     : ekuvector(alloc) {
   /* the rest of the move operation changes if source and
      destination have equivalent allocators */
@@ -477,6 +1557,9 @@ ekuvector<Type, Allocator>::ekuvector(ekuvector &&other, const Allocator &alloc)
     other.size_ = 0;
     other.capacity_ = 0;
     other.data_ = nullptr;
+    other.invalidate_iterators();
+    Stats::on_storage_change(size_, capacity_);
+    other.on_storage_change(0, 0);
   } else {
     // preallocate a new memory block and move construct the elements in the
     // original container into the destination
@@ -488,636 +1571,1524 @@ ekuvector<Type, Allocator>::ekuvector(ekuvector &&other, const Allocator &alloc)
   }
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::ekuvector(std::initializer_list<Type> init,
-                                      const Allocator &alloc)
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(
+    std::initializer_list<Type> init, const Allocator &alloc)
     : ekuvector(alloc) {
-  /* preallocate memory space */
-  preallocate_capacity(init.size());
-  /* copy constructo elements at the end of this vector */
-  for (auto it = init.begin(); it != init.end(); ++it) {
-    emplace_back(*it);
-  }
+  assign_n(init.begin(), init.size());
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator>::~ekuvector() {
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ExecutionPolicy, class>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(ExecutionPolicy &&policy,
+                                                     size_type count,
+                                                     const Type &value,
+                                                     const Allocator &alloc)
+    : ekuvector(alloc) {
+  assign(policy, count, value);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ExecutionPolicy, class>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(ExecutionPolicy &&policy,
+                                                     const ekuvector &other)
+    : ekuvector(policy, other,
+                std::allocator_traits<allocator_type>::
+                    select_on_container_copy_construction(
+                        other.get_allocator())) {}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ExecutionPolicy, class>
+ekuvector<Type, Allocator, Growth, Stats>::ekuvector(ExecutionPolicy &&policy,
+                                                     const ekuvector &other,
+                                                     const Allocator &alloc)
+    : ekuvector(alloc) {
+  preallocate_capacity(other.size_);
+  const auto source = other.raw_data();
+  parallel_construct(policy, other.size_,
+                     [this, source](Type *dst, size_type first,
+                                    size_type count) {
+                       detail::copy_construct_n(allocator_, source + first,
+                                                count, dst);
+                     });
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats>::~ekuvector() {
   /* make sure all destructors get called before I release the memory block */
   clear();
   /* release memory */
   if (capacity_) {
-    allocator_.deallocate(data_, capacity_);
+    deallocate_block(data_, capacity_);
     capacity_ = 0;
   }
+  Stats::on_storage_change(0, 0);
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::reserve(size_type new_cap) {
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::reserve(size_type new_cap) {
   /* if the new capacity is smaller than the current size, don't do anything */
   if (new_cap <= capacity_) {
     return;
   }
+  reallocate(Growth::fit_capacity(new_cap, sizeof(Type)));
+}
 
-  auto new_data_ptr = allocator_.allocate(new_cap);
-  auto new_capacity = new_cap;
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::reserve_exact(
+    size_type new_cap) {
+  if (new_cap <= capacity_) {
+    return;
+  }
+  reallocate(new_cap);
+}
 
-  for (size_t index = 0; index < size_; ++index) {
-    allocator_.construct(new_data_ptr + index, std::move(*(data_ + index)));
+template <class Type, class Allocator, class Growth, class Stats>
+bool ekuvector<Type, Allocator, Growth, Stats>::try_reserve(
+    size_type new_cap) noexcept {
+  if (new_cap > max_size()) {
+    return false;
+  }
+  /* reallocate() gives the strong guarantee, so nothing changed if it threw */
+  try {
+    reserve(new_cap);
+  } catch (...) {
+    return false;
   }
+  return true;
+}
 
-  /* destroy the empty shells left in the old buffer, and then release it */
-  clear();
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::next_capacity(
+    size_type required) const noexcept {
+  if (required <= capacity_) {
+    return capacity_;
+  }
+  return grown_capacity(required);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::grown_capacity(
+    size_type required) const noexcept {
+  return Growth::next_capacity(capacity_, required, sizeof(Type));
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::reallocate(size_type new_cap) {
+  if (resize_block(new_cap)) {
+    return;
+  }
+  pointer new_block = nullptr;
+  if (new_cap) {
+    new_block = allocate_block(new_cap);
+  }
+  auto new_capacity = new_cap;
+
+  /* move the contents to the new block, and then release the old one */
+  try {
+    detail::relocate_around(allocator_, detail::to_address(new_block),
+                            raw_data(), size_, 0, size_);
+  } catch (...) {
+    deallocate_block(new_block, new_cap);
+    throw;
+  }
+  Stats::on_relocate(size_);
   if (capacity_) {
-    allocator_.deallocate(data_, capacity_);
+    deallocate_block(data_, capacity_);
   }
 
   /* replace with the new block */
-  data_ = new_data_ptr;
+  data_ = new_block;
+  invalidate_iterators();
   capacity_ = new_capacity;
+  Stats::on_storage_change(size_, capacity_);
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::preallocate_capacity(size_type new_cap) {
-  /* if the new capacity is smaller than the current size, don't do anything */
-  auto rounded_size = ((new_cap + 1023) / 1024) * 1024;
-  reserve(rounded_size);
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::preallocate_capacity(
+    size_type new_cap) {
+  /* if there's already enough room, don't do anything */
+  if (new_cap <= capacity_) {
+    return;
+  }
+  /* let the growth policy decide how much room to make */
+  reallocate(grown_capacity(new_cap));
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ExecutionPolicy, class Construct>
+void ekuvector<Type, Allocator, Growth, Stats>::parallel_construct(
+    ExecutionPolicy &policy, size_type count, Construct construct) {
+  const auto base = raw_data() + size_;
+  policy.for_each_chunk(
+      count,
+      [base, &construct](size_type first, size_type last) {
+        construct(base + first, first, last - first);
+      },
+      [this, base](size_type first, size_type last) {
+        detail::destroy_range(allocator_, base + first, base + last);
+      });
+  size_ += count;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class... Args>
+void ekuvector<Type, Allocator, Growth, Stats>::realloc_emplace(
+    size_type ordinal, Args &&... args) {
+  const auto new_capacity = grown_capacity(size_ + 1);
+  if (resize_emplace(new_capacity, ordinal,
+                     detail::block_resize_tag<Allocator, Type>{},
+                     std::forward<Args>(args)...)) {
+    return;
+  }
+  auto new_block = allocate_block(new_capacity);
+  auto new_data_ptr = detail::to_address(new_block);
+
+  /* args may refer to an element of this container, so the new element must
+     be built before the old ones get moved away */
+  try {
+    detail::construct(allocator_, new_data_ptr + ordinal,
+                      std::forward<Args>(args)...);
+  } catch (...) {
+    deallocate_block(new_block, new_capacity);
+    throw;
+  }
+
+  /* move the contents around the new element, and release the old block */
+  try {
+    detail::relocate_around(allocator_, new_data_ptr, raw_data(), ordinal, 1,
+                            size_);
+  } catch (...) {
+    detail::destroy(allocator_, new_data_ptr + ordinal);
+    deallocate_block(new_block, new_capacity);
+    throw;
+  }
+  Stats::on_relocate(size_);
+  if (capacity_) {
+    deallocate_block(data_, capacity_);
+  }
+
+  data_ = new_block;
+  invalidate_iterators();
+  capacity_ = new_capacity;
+  ++size_;
+  Stats::on_storage_change(size_, capacity_);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::realloc_fill(
+    size_type new_cap, size_type ordinal, size_type count, const Type &value) {
+  auto new_block = allocate_block(new_cap);
+  auto new_data_ptr = detail::to_address(new_block);
+  try {
+    detail::fill_construct_n(allocator_, new_data_ptr + ordinal, count, value);
+  } catch (...) {
+    deallocate_block(new_block, new_cap);
+    throw;
+  }
+
+  /* move the contents around the copies, and release the old block */
+  try {
+    detail::relocate_around(allocator_, new_data_ptr, raw_data(), ordinal,
+                            count, size_);
+  } catch (...) {
+    detail::destroy_range(allocator_, new_data_ptr + ordinal,
+                          new_data_ptr + ordinal + count);
+    deallocate_block(new_block, new_cap);
+    throw;
+  }
+  Stats::on_relocate(size_);
+  if (capacity_) {
+    deallocate_block(data_, capacity_);
+  }
+
+  data_ = new_block;
+  invalidate_iterators();
+  capacity_ = new_cap;
+  size_ += count;
+  Stats::on_storage_change(size_, capacity_);
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator> &ekuvector<Type, Allocator>::
-operator=(const ekuvector &other) {
-  /* clear up the current contents */
-  clear();
-  preallocate_capacity(other.size());
-  /* copy construct the elements in place */
-  for (auto it = other.begin(); it != other.end(); ++it) {
-    emplace_back(*it);
+template <class Type, class Allocator, class Growth, class Stats>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_block(
+    size_type new_cap) {
+  return resize_block(new_cap, detail::block_resize_tag<Allocator, Type>{});
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_block(size_type new_cap,
+                                                             std::true_type) {
+  if (!capacity_ || !new_cap) {
+    return false;
   }
-  return *this;
+  data_ = allocator_.reallocate(data_, capacity_, new_cap);
+  invalidate_iterators();
+  Stats::on_deallocate(capacity_, sizeof(Type));
+  Stats::on_allocate(new_cap, sizeof(Type));
+  capacity_ = new_cap;
+  Stats::on_storage_change(size_, capacity_);
+  return true;
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator> &ekuvector<Type, Allocator>::
-operator=(ekuvector &&other) {
-  /* clear up the current contents */
-  clear();
-  preallocate_capacity(other.size());
-  /* move-insert the element from the source here*/
-  for (auto it = other.begin(); it != other.end(); ++it) {
-    emplace_back(std::move(*it));
+template <class Type, class Allocator, class Growth, class Stats>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_block(
+    size_type /* new_cap */, std::false_type) noexcept {
+  return false;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class... Args>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_emplace(
+    size_type new_cap, size_type ordinal, std::true_type, Args &&... args) {
+  if (!capacity_) {
+    return false;
   }
-  return *this;
+  /* args may refer to an element of this container, which may move along
+     with the block */
+  Type value(std::forward<Args>(args)...);
+  resize_block(new_cap, std::true_type{});
+  auto gap = raw_data() + ordinal;
+  detail::relocate_backward(allocator_, gap + 1, gap, size_ - ordinal);
+  detail::construct(allocator_, gap, std::move(value));
+  ++size_;
+  return true;
 }
 
-template <class Type, class Allocator>
-ekuvector<Type, Allocator> &ekuvector<Type, Allocator>::
-operator=(std::initializer_list<Type> ilist) {
-  /* clear up the current contents */
-  clear();
-  preallocate_capacity(ilist.size());
-  /* copy the contents for the initialization list */
-  for (auto it = ilist.begin(); it != ilist.end(); ++it) {
-    emplace_back(*it);
+template <class Type, class Allocator, class Growth, class Stats>
+template <class... Args>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_emplace(
+    size_type /* new_cap */, size_type /* ordinal */, std::false_type,
+    Args &&... /* args */) noexcept {
+  return false;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ForwardIt>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_insert(
+    size_type new_cap, size_type ordinal, ForwardIt first, size_type count,
+    std::true_type) {
+  if (!capacity_) {
+    return false;
   }
-  return *this;
+  if (detail::range_aliases(first, raw_data(), size_)) {
+    /* the range comes from this container, which may move along with the
+       block, so it's copied out of the way first */
+    ekuvector<Type> staged(first, std::next(first, count));
+    return resize_insert(new_cap, ordinal,
+                         std::make_move_iterator(staged.data()), count,
+                         std::true_type{});
+  }
+  resize_block(new_cap, std::true_type{});
+  const auto tail_size = size_ - ordinal;
+  auto gap = raw_data() + ordinal;
+  detail::relocate_backward(allocator_, gap + count, gap, tail_size);
+  try {
+    detail::copy_construct_n(allocator_, first, count, gap);
+  } catch (...) {
+    detail::relocate_forward(allocator_, gap, gap + count, tail_size);
+    throw;
+  }
+  return true;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::assign(size_type count, const Type &value) {
-  if (count) {
-    /* allocate memory space for at least count elements */
-    preallocate_capacity(count);
-    /* call a copy constructor on each */
-    for (size_t index = 0; index < count; ++index) {
-      /* if the element was previously constructed, destroy it first */
-      if (index < size_) {
-        allocator_.destroy(data_ + index);
-      } else {
-        ++size_;
-      }
-      /* copy construct in place */
-      allocator_.construct(data_ + index, value);
-    }
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ForwardIt>
+bool ekuvector<Type, Allocator, Growth, Stats>::resize_insert(
+    size_type /* new_cap */, size_type /* ordinal */, ForwardIt /* first */,
+    size_type /* count */, std::false_type) noexcept {
+  return false;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ForwardIt>
+void ekuvector<Type, Allocator, Growth, Stats>::assign_n(ForwardIt first,
+                                                         size_type count) {
+  if (count > capacity_) {
+    /* no room for the new contents, start over in a new block */
+    clear();
+    reserve(count);
+  }
+  const auto common = std::min(size_, count);
+  first = detail::copy_assign_n(first, common, raw_data());
+  if (count > size_) {
+    detail::copy_construct_n(allocator_, first, count - size_,
+                             raw_data() + size_);
+  } else {
+    detail::destroy_range(allocator_, raw_data() + count, raw_data() + size_);
   }
+  size_ = count;
 }
 
-template <class Type, class Allocator>
+template <class Type, class Allocator, class Growth, class Stats>
 template <class InputIt>
-void ekuvector<Type, Allocator>::assign(
-    InputIt first,
-    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
-  /* call a copy constructor on each */
-  size_t index = 0;
-  for (auto it = first; it != last; ++it, ++index) {
-    /* make sure we have enough capacity */
-    if (capacity_ < index + 1) {
-      preallocate_capacity(index + 1);
+void ekuvector<Type, Allocator, Growth, Stats>::assign_range(
+    InputIt first, InputIt last, std::input_iterator_tag) {
+  /* copy-assign over the live elements while there are any */
+  auto it = first;
+  size_type index = 0;
+  for (; (it != last) && (index < size_); ++it, ++index) {
+    *(raw_data() + index) = *it;
+  }
+  /* then either destroy the leftovers, or append the rest of the range */
+  detail::destroy_range(allocator_, raw_data() + index, raw_data() + size_);
+  size_ = index;
+  for (; it != last; ++it) {
+    emplace_back(*it);
+  }
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ForwardIt>
+void ekuvector<Type, Allocator, Growth, Stats>::assign_range(
+    ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+  assign_n(first, static_cast<size_type>(std::distance(first, last)));
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class InputIt>
+void ekuvector<Type, Allocator, Growth, Stats>::insert_range(
+    size_type ordinal, InputIt first, InputIt last, std::input_iterator_tag) {
+  const auto old_size = size_;
+  for (auto it = first; it != last; ++it) {
+    emplace_back(*it);
+  }
+  std::rotate(raw_data() + ordinal, raw_data() + old_size, raw_data() + size_);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ForwardIt>
+void ekuvector<Type, Allocator, Growth, Stats>::insert_range(
+    size_type ordinal, ForwardIt first, ForwardIt last,
+    std::forward_iterator_tag) {
+  const auto count = static_cast<size_type>(std::distance(first, last));
+  if (count == 0) {
+    return;
+  }
+  const auto tail_size = size_ - ordinal;
+  const auto grows = size_ + count > capacity_;
+  const auto in_place =
+      !grows &&
+      (!tail_size || detail::gap_relocation_tag<Allocator, Type>::value);
+  if (in_place && detail::range_aliases(first, raw_data(), size_)) {
+    /* the tail is about to be shifted over the range, so copy it aside */
+    ekuvector<Type> staged(first, last);
+    insert_range(ordinal, std::make_move_iterator(staged.data()),
+                 std::make_move_iterator(staged.data() + count),
+                 std::forward_iterator_tag{});
+    return;
+  }
+  if (!in_place) {
+    /* build the new elements in a new block, and then relocate the old ones
+       around them, so that each element gets moved only once. That's also
+       done without growing when the tail can't be shifted safely */
+    const auto new_capacity = grows ? grown_capacity(size_ + count) : capacity_;
+    if (resize_insert(new_capacity, ordinal, first, count,
+                      detail::block_resize_tag<Allocator, Type>{})) {
+      size_ += count;
+      return;
     }
-    /* if the element was previously constructed, destroy  it first */
-    if (index < size_) {
-      allocator_.destroy(data_ + index);
-    } else {
-      ++size_;
+    auto new_block = allocate_block(new_capacity);
+    auto new_data_ptr = detail::to_address(new_block);
+    try {
+      detail::copy_construct_n(allocator_, first, count,
+                               new_data_ptr + ordinal);
+    } catch (...) {
+      deallocate_block(new_block, new_capacity);
+      throw;
+    }
+    try {
+      detail::relocate_around(allocator_, new_data_ptr, raw_data(), ordinal,
+                              count, size_);
+    } catch (...) {
+      detail::destroy_range(allocator_, new_data_ptr + ordinal,
+                            new_data_ptr + ordinal + count);
+      deallocate_block(new_block, new_capacity);
+      throw;
+    }
+    Stats::on_relocate(size_);
+    if (capacity_) {
+      deallocate_block(data_, capacity_);
+    }
+    data_ = new_block;
+    invalidate_iterators();
+    capacity_ = new_capacity;
+    Stats::on_storage_change(size_ + count, capacity_);
+  } else {
+    /* open a gap for the new elements, and close it again if the copies
+       fail */
+    auto gap = raw_data() + ordinal;
+    detail::relocate_backward(allocator_, gap + count, gap, tail_size);
+    try {
+      detail::copy_construct_n(allocator_, first, count, gap);
+    } catch (...) {
+      detail::relocate_forward(allocator_, gap, gap + count, tail_size);
+      throw;
     }
-    /* copy construct in place */
-    allocator_.construct(data_ + index, *it);
   }
+  size_ += count;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::assign(std::initializer_list<Type> ilist) {
-  /* call a copy constructor on each */
-  size_t index = 0;
-  for (auto it = ilist.begin(); it != ilist.end(); ++it, ++index) {
-    /* make sure we have enough capacity */
-    if (capacity_ < index + 1) {
-      preallocate_capacity(index + 1);
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats> &
+ekuvector<Type, Allocator, Growth, Stats>::operator=(const ekuvector &other) {
+  if (this == &other) {
+    return *this;
+  }
+  using propagate =
+      typename alloc_traits::propagate_on_container_copy_assignment;
+  if (propagate::value && (allocator_ != other.allocator_)) {
+    /* memory from the old allocator must be returned to it */
+    clear();
+    reallocate(0);
+  }
+  detail::propagate_allocator(allocator_, other.allocator_, propagate{});
+  assign_n(other.raw_data(), other.size_);
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats> &
+ekuvector<Type, Allocator, Growth, Stats>::operator=(
+    ekuvector &&other) noexcept(
+    detail::nothrow_move_assignment<Allocator>::value) {
+  if (this == &other) {
+    return *this;
+  }
+  using propagate =
+      typename alloc_traits::propagate_on_container_move_assignment;
+  if (propagate::value || (allocator_ == other.allocator_)) {
+    /* release the current contents and take over the block owned by other */
+    clear();
+    if (capacity_) {
+      deallocate_block(data_, capacity_);
     }
-    /* if the element was previously constructed, destroy first */
-    if (index < size_) {
-      allocator_.destroy(data_ + index);
+    detail::propagate_allocator(allocator_, std::move(other.allocator_),
+                                propagate{});
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    data_ = other.data_;
+    invalidate_iterators();
+    /* empty source object, leaving in a safe state */
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.data_ = nullptr;
+    other.invalidate_iterators();
+    Stats::on_storage_change(size_, capacity_);
+    other.on_storage_change(0, 0);
+  } else {
+    /* the block of other can't be released through allocator_, so the
+       elements have to be moved one by one */
+    const auto common = std::min(size_, other.size_);
+    std::move(other.raw_data(), other.raw_data() + common, raw_data());
+    if (size_ > other.size_) {
+      detail::destroy_range(allocator_, raw_data() + other.size_,
+                            raw_data() + size_);
+      size_ = other.size_;
     } else {
-      ++size_;
+      preallocate_capacity(other.size_);
+      while (size_ < other.size_) {
+        emplace_back(std::move(other[size_]));
+      }
     }
-    /* copy construct in place */
-    allocator_.construct(data_ + index, *it);
   }
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+ekuvector<Type, Allocator, Growth, Stats> &
+ekuvector<Type, Allocator, Growth, Stats>::
+operator=(std::initializer_list<Type> ilist) {
+  assign_n(ilist.begin(), ilist.size());
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::assign(size_type count,
+                                                       const Type &value) {
+  if (count > capacity_) {
+    /* no room for the new contents, start over in a new block */
+    clear();
+    reserve(count);
+  }
+  const auto common = std::min(size_, count);
+  std::fill_n(raw_data(), common, value);
+  if (count > size_) {
+    detail::fill_construct_n(allocator_, raw_data() + size_, count - size_,
+                             value);
+  } else {
+    detail::destroy_range(allocator_, raw_data() + count, raw_data() + size_);
+  }
+  size_ = count;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ExecutionPolicy, class>
+void ekuvector<Type, Allocator, Growth, Stats>::assign(ExecutionPolicy &&policy,
+                                                       size_type count,
+                                                       const Type &value) {
+  clear(policy);
+  if (count > capacity_) {
+    reserve(count);
+  }
+  parallel_construct(policy, count,
+                     [this, &value](Type *dst, size_type /* first */,
+                                    size_type chunk) {
+                       detail::fill_construct_n(allocator_, dst, chunk, value);
+                     });
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class InputIt>
+void ekuvector<Type, Allocator, Growth, Stats>::assign(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  assign_range(first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::allocator_type
-ekuvector<Type, Allocator>::get_allocator() const {
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::assign(
+    std::initializer_list<Type> ilist) {
+  assign_n(ilist.begin(), ilist.size());
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::allocator_type
+ekuvector<Type, Allocator, Growth, Stats>::get_allocator() const {
   return allocator_;
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::reference
-ekuvector<Type, Allocator>::at(size_type pos) {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::reference
+ekuvector<Type, Allocator, Growth, Stats>::at(size_type pos) {
   if (pos >= size_) {
     throw std::out_of_range("vector index out of range");
   }
-  return *(data_ + pos);
+  return *(raw_data() + pos);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reference
-ekuvector<Type, Allocator>::at(size_type pos) const {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reference
+ekuvector<Type, Allocator, Growth, Stats>::at(size_type pos) const {
   if (pos >= size_) {
     throw std::out_of_range("vector index out of range");
   }
-  return *(data_ + pos);
+  return *(raw_data() + pos);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::reference ekuvector<Type, Allocator>::
-operator[](size_type pos) {
-  return *(data_ + pos);
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::reference
+    ekuvector<Type, Allocator, Growth, Stats>::operator[](size_type pos) {
+  EKUVECTOR_CHECK(pos < size_, "ekuvector index out of range");
+  return *(raw_data() + pos);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reference
-    ekuvector<Type, Allocator>::operator[](size_type pos) const {
-  return *(data_ + pos);
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reference
+    ekuvector<Type, Allocator, Growth, Stats>::operator[](size_type pos) const {
+  EKUVECTOR_CHECK(pos < size_, "ekuvector index out of range");
+  return *(raw_data() + pos);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::reference
-ekuvector<Type, Allocator>::front() {
-  return *data_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::reference
+ekuvector<Type, Allocator, Growth, Stats>::front() {
+  EKUVECTOR_CHECK(size_ > 0, "ekuvector::front() on an empty container");
+  return *raw_data();
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reference
-ekuvector<Type, Allocator>::front() const {
-  return *data_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reference
+ekuvector<Type, Allocator, Growth, Stats>::front() const {
+  EKUVECTOR_CHECK(size_ > 0, "ekuvector::front() on an empty container");
+  return *raw_data();
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::reference
-ekuvector<Type, Allocator>::back() {
-  return (*this)[size_ - 1];
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::reference
+ekuvector<Type, Allocator, Growth, Stats>::back() {
+  EKUVECTOR_CHECK(size_ > 0, "ekuvector::back() on an empty container");
+  return *(raw_data() + size_ - 1);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reference
-ekuvector<Type, Allocator>::back() const {
-  return (*this)[size_ - 1];
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reference
+ekuvector<Type, Allocator, Growth, Stats>::back() const {
+  EKUVECTOR_CHECK(size_ > 0, "ekuvector::back() on an empty container");
+  return *(raw_data() + size_ - 1);
 }
 
-template <class Type, class Allocator>
-Type *ekuvector<Type, Allocator>::data() noexcept {
-  return data_;
+template <class Type, class Allocator, class Growth, class Stats>
+Type *ekuvector<Type, Allocator, Growth, Stats>::data() noexcept {
+  return raw_data();
 }
 
-template <class Type, class Allocator>
-const Type *ekuvector<Type, Allocator>::data() const noexcept {
-  return data_;
+template <class Type, class Allocator, class Growth, class Stats>
+const Type *ekuvector<Type, Allocator, Growth, Stats>::data() const noexcept {
+  return raw_data();
 }
 
 /* *** */
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::begin() noexcept {
-  return data_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::begin() noexcept {
+  return make_iterator(raw_data());
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_iterator
-ekuvector<Type, Allocator>::begin() const noexcept {
-  return data_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_iterator
+ekuvector<Type, Allocator, Growth, Stats>::begin() const noexcept {
+  return make_iterator(static_cast<const Type *>(raw_data()));
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_iterator
-ekuvector<Type, Allocator>::cbegin() const noexcept {
-  return data_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_iterator
+ekuvector<Type, Allocator, Growth, Stats>::cbegin() const noexcept {
+  return begin();
 }
 
 /* *** */
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::end() noexcept {
-  return data_ + size_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::end() noexcept {
+  return make_iterator(raw_data() + size_);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_iterator
-ekuvector<Type, Allocator>::end() const noexcept {
-  return data_ + size_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_iterator
+ekuvector<Type, Allocator, Growth, Stats>::end() const noexcept {
+  return make_iterator(static_cast<const Type *>(raw_data() + size_));
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_iterator
-ekuvector<Type, Allocator>::cend() const noexcept {
-  return data_ + size_;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_iterator
+ekuvector<Type, Allocator, Growth, Stats>::cend() const noexcept {
+  return end();
 }
 
 /* *** */
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::reverse_iterator
-ekuvector<Type, Allocator>::rbegin() noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::reverse_iterator
+ekuvector<Type, Allocator, Growth, Stats>::rbegin() noexcept {
   return reverse_iterator(end());
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reverse_iterator
-ekuvector<Type, Allocator>::rbegin() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reverse_iterator
+ekuvector<Type, Allocator, Growth, Stats>::rbegin() const noexcept {
   return const_reverse_iterator(end());
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reverse_iterator
-ekuvector<Type, Allocator>::crbegin() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reverse_iterator
+ekuvector<Type, Allocator, Growth, Stats>::crbegin() const noexcept {
   return const_reverse_iterator(end());
 }
 
 /* *** */
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::reverse_iterator
-ekuvector<Type, Allocator>::rend() noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::reverse_iterator
+ekuvector<Type, Allocator, Growth, Stats>::rend() noexcept {
   return reverse_iterator{begin()};
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reverse_iterator
-ekuvector<Type, Allocator>::rend() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reverse_iterator
+ekuvector<Type, Allocator, Growth, Stats>::rend() const noexcept {
   return const_reverse_iterator{begin()};
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::const_reverse_iterator
-ekuvector<Type, Allocator>::crend() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_reverse_iterator
+ekuvector<Type, Allocator, Growth, Stats>::crend() const noexcept {
   return const_reverse_iterator{begin()};
 }
 
 /* *** */
 
-template <class Type, class Allocator>
-bool ekuvector<Type, Allocator>::empty() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+bool ekuvector<Type, Allocator, Growth, Stats>::empty() const noexcept {
   return (size_ == 0);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::size_type
-ekuvector<Type, Allocator>::size() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::size() const noexcept {
   return size_;
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::size_type
-ekuvector<Type, Allocator>::max_size() const noexcept {
-  return INT32_MAX;
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::max_size() const noexcept {
+  return std::min<size_type>(alloc_traits::max_size(allocator_),
+                             std::numeric_limits<difference_type>::max());
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::size_type
-ekuvector<Type, Allocator>::capacity() const noexcept {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::capacity() const noexcept {
   return capacity_;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::shrink_to_fit() {
-  /* the standard allows to ignore this request */
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::shrink_to_fit() {
+  const auto new_capacity =
+      size_ ? Growth::fit_capacity(size_, sizeof(Type)) : 0;
+  if (new_capacity < capacity_) {
+    reallocate(new_capacity);
+  }
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::clear() noexcept {
+  detail::destroy_range(allocator_, raw_data(), raw_data() + size_);
+  size_ = 0;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::clear() noexcept {
-  while (size()) {
-    pop_back();
+template <class Type, class Allocator, class Growth, class Stats>
+template <class ExecutionPolicy, class>
+void ekuvector<Type, Allocator, Growth, Stats>::clear(
+    ExecutionPolicy &&policy) noexcept {
+  if (std::is_trivially_destructible<Type>::value &&
+      detail::default_element_ops<Allocator, Type>::value) {
+    /* nothing to run, no point in waking up any threads */
+    size_ = 0;
+    return;
   }
+  const auto base = raw_data();
+  auto destroy = [this, base](size_type first, size_type last) noexcept {
+    detail::destroy_range(allocator_, base + first, base + last);
+  };
+  auto keep = [](size_type /* first */, size_type /* last */) noexcept {};
+  static_assert(noexcept(policy.for_each_chunk(size_, destroy, keep)),
+                "clear() requires a for_each_chunk() that doesn't throw when "
+                "the work can't");
+  policy.for_each_chunk(size_, destroy, keep);
+  size_ = 0;
 }
 
 /* *** */
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::insert(const_iterator pos, const Type &value) {
-  const auto pos_ordinal = empty() ? 0 : std::distance(cbegin(), pos);
-  push_back(value); // this can invalidate pos
-  auto new_pos = begin() + pos_ordinal;
-  auto index = end() - 1;
-  while (index != new_pos) {
-    std::swap(*index, *(index - 1));
-    --index;
-  }
-  return new_pos;
-}
-
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::insert(const_iterator pos, Type &&value) {
-  const auto pos_ordinal = empty() ? 0 : std::distance(cbegin(), pos);
-  push_back(std::move(value)); // this can invalidate pos
-  auto new_pos = begin() + pos_ordinal;
-  auto index = end() - 1;
-  while (index != new_pos) {
-    std::swap(*index, *(index - 1));
-    --index;
-  }
-  return new_pos;
-}
-
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::insert(const_iterator pos, size_type count,
-                                   const Type &value) {
-  const auto &elements_to_insert = count;
-  iterator new_pos;
-  if (elements_to_insert > 0) {
-    const auto pos_ordinal = empty() ? 0 : std::distance(cbegin(), pos);
-    preallocate_capacity(size() +
-                         elements_to_insert); // this can invalidate pos
-    new_pos = begin() + pos_ordinal;
-    // move everything past pos towards the end of the vector
-    {
-      const auto end_mark = new_pos - 1;
-      auto dst = end() + elements_to_insert - 1;
-      auto src = dst - elements_to_insert;
-      while (src != end_mark) {
-        allocator_.construct(dst, std::move(*src));
-        allocator_.destroy(src); // destruct residual object
-        --src;
-        --dst;
-      }
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::insert(const_iterator pos,
+                                                  const Type &value) {
+  const auto pos_ordinal = ordinal_of(pos);
+  if (size_ == capacity_) {
+    realloc_emplace(pos_ordinal, value);
+  } else if (pos_ordinal == size_) {
+    detail::construct(allocator_, raw_data() + size_, value);
+    ++size_;
+  } else {
+    /* value may be an element of the tail that's about to be shifted */
+    auto new_pos = raw_data() + pos_ordinal;
+    auto old_end = raw_data() + size_;
+    auto value_ptr = std::addressof(value);
+    if ((new_pos <= value_ptr) && (value_ptr < old_end)) {
+      ++value_ptr;
     }
-    // copy construct the new contents in place. The places are currently empty
-    {
-      auto dst = new_pos;
-      for (size_t i = 0; i < count; ++i, ++dst) {
-        allocator_.construct(dst, value);
-      }
+    detail::shift_insert(allocator_, new_pos, old_end, *value_ptr);
+    ++size_;
+  }
+  return make_iterator(raw_data() + pos_ordinal);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::insert(const_iterator pos,
+                                                  Type &&value) {
+  const auto pos_ordinal = ordinal_of(pos);
+  if (size_ == capacity_) {
+    realloc_emplace(pos_ordinal, std::move(value));
+  } else if (pos_ordinal == size_) {
+    detail::construct(allocator_, raw_data() + size_, std::move(value));
+    ++size_;
+  } else {
+    detail::shift_insert(allocator_, raw_data() + pos_ordinal,
+                         raw_data() + size_, std::move(value));
+    ++size_;
+  }
+  return make_iterator(raw_data() + pos_ordinal);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::insert(const_iterator pos,
+                                                  size_type count,
+                                                  const Type &value) {
+  const auto pos_ordinal = ordinal_of(pos);
+  if (count == 0) {
+    return make_iterator(raw_data() + pos_ordinal);
+  }
+  /* value may be an element that's about to be moved around */
+  const Type value_copy(value);
+  const auto tail_size = size_ - pos_ordinal;
+  if (size_ + count > capacity_) {
+    const auto new_capacity = grown_capacity(size_ + count);
+    if (!resize_block(new_capacity)) {
+      realloc_fill(new_capacity, pos_ordinal, count, value_copy);
+      return make_iterator(raw_data() + pos_ordinal);
     }
-    size_ += elements_to_insert;
+  } else if (tail_size &&
+             !detail::gap_relocation_tag<Allocator, Type>::value) {
+    /* the tail can't be shifted safely, so it goes to a block of its own */
+    realloc_fill(capacity_, pos_ordinal, count, value_copy);
+    return make_iterator(raw_data() + pos_ordinal);
+  }
+  /* open a gap for the copies, and close it again if they fail */
+  auto gap = raw_data() + pos_ordinal;
+  detail::relocate_backward(allocator_, gap + count, gap, tail_size);
+  try {
+    detail::fill_construct_n(allocator_, gap, count, value_copy);
+  } catch (...) {
+    detail::relocate_forward(allocator_, gap, gap + count, tail_size);
+    throw;
   }
-  return new_pos;
+  size_ += count;
+  return make_iterator(raw_data() + pos_ordinal);
 }
 
-template <class Type, class Allocator>
+template <class Type, class Allocator, class Growth, class Stats>
 template <class InputIt>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::insert(
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::insert(
     const_iterator pos, InputIt first,
     typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
-  const auto elements_to_insert = std::distance(first, last);
-  iterator new_pos;
-  if (elements_to_insert > 0) {
-    const auto pos_ordinal = empty() ? 0 : std::distance(cbegin(), pos);
-    preallocate_capacity(size() +
-                         elements_to_insert); // this can invalidate pos
-    new_pos = begin() + pos_ordinal;
-    // move everything past pos towards the end of the vector
-    {
-      const auto end_mark = new_pos - 1;
-      auto dst = end() + elements_to_insert - 1;
-      auto src = dst - elements_to_insert;
-      while (src != end_mark) {
-        allocator_.construct(dst, std::move(*src));
-        allocator_.destroy(src); // destruct residual object
-        --src;
-        --dst;
-      }
-    }
-    // copy construct the new contents in place. The places are currently empty
-    {
-      auto dst = new_pos;
-      for (auto it = first; it != last; ++it, ++dst) {
-        allocator_.construct(dst, *it);
-      }
-    }
-    size_ += elements_to_insert;
-  }
-  return new_pos;
+  const auto pos_ordinal = ordinal_of(pos);
+  insert_range(pos_ordinal, first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
+  return make_iterator(raw_data() + pos_ordinal);
 }
 
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::insert(const_iterator pos,
-                                   std::initializer_list<Type> ilist) {
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::insert(
+    const_iterator pos, std::initializer_list<Type> ilist) {
   return insert(pos, ilist.begin(), ilist.end());
 }
 
-template <class Type, class Allocator>
+template <class Type, class Allocator, class Growth, class Stats>
 template <class... Args>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::emplace(const_iterator pos, Args &&... args) {
-  const auto pos_ordinal = empty() ? 0 : std::distance(cbegin(), pos);
-  emplace_back(std::forward<Args>(args)...);
-  const auto new_pos = begin() + pos_ordinal;
-  auto index = end() - 1;
-  while (index != new_pos) {
-    std::swap(*index, *(index - 1));
-    --index;
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::emplace(const_iterator pos,
+                                                   Args &&... args) {
+  const auto pos_ordinal = ordinal_of(pos);
+  if (size_ == capacity_) {
+    realloc_emplace(pos_ordinal, std::forward<Args>(args)...);
+  } else if (pos_ordinal == size_) {
+    detail::construct(allocator_, raw_data() + size_,
+                      std::forward<Args>(args)...);
+    ++size_;
+  } else {
+    /* args may refer to an element of the tail that's about to be shifted,
+       so the new element is built aside before making room for it */
+    Type value(std::forward<Args>(args)...);
+    detail::shift_insert(allocator_, raw_data() + pos_ordinal,
+                         raw_data() + size_, std::move(value));
+    ++size_;
   }
-  return new_pos;
-}
-
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::erase(const_iterator pos) {
-  /* Move the element at pos towards the end of the vector, then remove it */
-  iterator non_const_pos = begin() + std::distance(cbegin(), pos);
-  auto index = non_const_pos;
-  while ((index + 1) != end()) {
-    std::swap(*index, *(index + 1));
-    ++index;
+  return make_iterator(raw_data() + pos_ordinal);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::erase(const_iterator pos) {
+  const auto pos_ordinal = ordinal_of(pos);
+  EKUVECTOR_CHECK(pos_ordinal < size_, "ekuvector::erase() past the end");
+  auto head = raw_data() + pos_ordinal;
+  auto new_end =
+      detail::erase_range(allocator_, head, head + 1, raw_data() + size_);
+  size_ = static_cast<size_type>(new_end - raw_data());
+  return make_iterator(head);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::erase(const_iterator first,
+                                                 const_iterator last) {
+  const auto first_ordinal = ordinal_of(first);
+  const auto last_ordinal = ordinal_of(last);
+  EKUVECTOR_CHECK(first_ordinal <= last_ordinal,
+                  "ekuvector::erase() of a reversed range");
+  auto head = raw_data() + first_ordinal;
+  auto new_end = detail::erase_range(allocator_, head,
+                                     raw_data() + last_ordinal,
+                                     raw_data() + size_);
+  size_ = static_cast<size_type>(new_end - raw_data());
+  return make_iterator(head);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::erase_unordered(
+    const_iterator pos) {
+  const auto pos_ordinal = ordinal_of(pos);
+  EKUVECTOR_CHECK(pos_ordinal < size_,
+                  "ekuvector::erase_unordered() past the end");
+  auto hole = raw_data() + pos_ordinal;
+  auto last = raw_data() + size_ - 1;
+  if (hole != last) {
+    *hole = std::move(*last);
   }
-  pop_back();
-  return non_const_pos;
-}
-
-template <class Type, class Allocator>
-typename ekuvector<Type, Allocator>::iterator
-ekuvector<Type, Allocator>::erase(const_iterator first, const_iterator last) {
-  /* Move the elements within both iterators towards the end, then remove them */
-  auto head = begin() + std::distance(cbegin(), first);
-  auto tail = begin() + std::distance(cbegin(), last);
-  auto return_it = head;
-
-  while (tail != end()) {
-    std::swap(*head, *tail);
-    ++head;
-    ++tail;
+  detail::destroy(allocator_, last);
+  --size_;
+  return make_iterator(hole);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class Predicate>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::erase_if(Predicate pred) {
+  auto first = raw_data();
+  auto last = raw_data() + size_;
+  auto kept = first;
+  while ((kept != last) && !pred(*kept)) {
+    ++kept;
   }
-
-  while (head != end()) {
-    pop_back();
+  /* from the first erased element on, move each survivor into place */
+  if (kept != last) {
+    for (auto it = kept + 1; it != last; ++it) {
+      if (!pred(*it)) {
+        *kept = std::move(*it);
+        ++kept;
+      }
+    }
   }
+  detail::destroy_range(allocator_, kept, last);
+  const auto erased = static_cast<size_type>(last - kept);
+  size_ -= erased;
+  return erased;
+}
 
-  return return_it;
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::push_back(const Type &value) {
+  emplace_back(value);
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::push_back(const Type &value) {
-  /* make sure there's enough storage */
-  preallocate_capacity(size_ + 1);
-  /* copy construct the new element */
-  allocator_.construct(data_ + size_, value);
-  ++size_;
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::push_back(Type &&value) {
+  emplace_back(std::move(value));
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::push_back(Type &&value) {
-  /* make sure there's enough storage */
-  preallocate_capacity(size_ + 1);
-  /* move construct the new element */
-  allocator_.construct(data_ + size_, std::forward<Type>(value));
-  ++size_;
+template <class Type, class Allocator, class Growth, class Stats>
+template <class... Args>
+void ekuvector<Type, Allocator, Growth, Stats>::emplace_back(Args &&... args) {
+  const auto old_size = size_;
+  if (old_size == capacity_) {
+    /* out of room, so the new element gets built in the new block. This
+       also keeps args valid if they refer to an element of this container */
+    realloc_emplace(old_size, std::forward<Args>(args)...);
+    return;
+  }
+  detail::construct(allocator_, raw_data() + old_size,
+                    std::forward<Args>(args)...);
+  size_ = old_size + 1;
 }
 
-template <class Type, class Allocator>
+template <class Type, class Allocator, class Growth, class Stats>
 template <class... Args>
-void ekuvector<Type, Allocator>::emplace_back(Args &&... args) {
-  /* make sure there's enough storage */
-  preallocate_capacity(size_ + 1);
-  /* copy construct the new element */
-  allocator_.construct(data_ + size_, std::forward<Args>(args)...);
+void ekuvector<Type, Allocator, Growth, Stats>::unchecked_emplace_back(
+    Args &&... args) {
+  detail::construct(allocator_, raw_data() + size_,
+                    std::forward<Args>(args)...);
   ++size_;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::pop_back() {
+template <class Type, class Allocator, class Growth, class Stats>
+template <class InputIt>
+void ekuvector<Type, Allocator, Growth, Stats>::append(
+    InputIt first,
+    typename std::enable_if<is_iterator<InputIt>::value, InputIt>::type last) {
+  insert_range(size_, first, last,
+               typename std::iterator_traits<InputIt>::iterator_category{});
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+template <class Generator>
+void ekuvector<Type, Allocator, Growth, Stats>::append(size_type count,
+                                                       Generator generator) {
+  preallocate_capacity(size_ + count);
+  const auto old_size = size_;
+  try {
+    for (size_type index = 0; index < count; ++index) {
+      detail::construct(allocator_, raw_data() + size_, generator());
+      ++size_;
+    }
+  } catch (...) {
+    detail::destroy_range(allocator_, raw_data() + old_size,
+                          raw_data() + size_);
+    size_ = old_size;
+    throw;
+  }
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::pop_back() {
   if (size_) {
     --size_;
-    allocator_.destroy(data_ + size_);
+    detail::destroy(allocator_, raw_data() + size_);
   }
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::resize(size_type count) {
-  resize(count, Type{});
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::resize(size_type count) {
+  if (count > size_) {
+    preallocate_capacity(count);
+    detail::value_construct_n(allocator_, raw_data() + size_, count - size_);
+  } else {
+    detail::destroy_range(allocator_, raw_data() + count, raw_data() + size_);
+  }
+  size_ = count;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::resize(size_type count,
-                                        const value_type &value) {
-  while (size_ < count) {
-    push_back(value);
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::resize(
+    size_type count, const value_type &value) {
+  if (count > capacity_) {
+    /* value may be an element of this container, so keep a copy around
+       before the storage gets replaced */
+    const Type value_copy(value);
+    preallocate_capacity(count);
+    resize(count, value_copy);
+    return;
+  }
+  if (count > size_) {
+    detail::fill_construct_n(allocator_, raw_data() + size_, count - size_,
+                             value);
+  } else {
+    detail::destroy_range(allocator_, raw_data() + count, raw_data() + size_);
   }
-  while (size_ > count) {
-    pop_back();
+  size_ = count;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::resize_default_init(
+    size_type count) {
+  if (count > size_) {
+    preallocate_capacity(count);
+    detail::default_construct_n(allocator_, raw_data() + size_, count - size_);
+  } else {
+    detail::destroy_range(allocator_, raw_data() + count, raw_data() + size_);
   }
+  size_ = count;
 }
 
-template <class Type, class Allocator>
-void ekuvector<Type, Allocator>::swap(ekuvector &other) {
-  std::swap(allocator_, other.allocator_);
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::swap(
+    ekuvector &other) noexcept {
+  detail::swap_allocators(
+      allocator_, other.allocator_,
+      typename alloc_traits::propagate_on_container_swap{});
   std::swap(data_, other.data_);
+  invalidate_iterators();
+  other.invalidate_iterators();
   std::swap(size_, other.size_);
   std::swap(capacity_, other.capacity_);
+  Stats::on_storage_change(size_, capacity_);
+  other.on_storage_change(other.size_, other.capacity_);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::released_block
+ekuvector<Type, Allocator, Growth, Stats>::release() noexcept {
+  released_block block{data_, size_, capacity_, allocator_};
+  if (capacity_) {
+    Stats::on_deallocate(capacity_, sizeof(Type));
+  }
+  data_ = nullptr;
+  invalidate_iterators();
+  size_ = 0;
+  capacity_ = 0;
+  Stats::on_storage_change(0, 0);
+  return block;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::adopt(
+    pointer data, size_type size, size_type capacity) noexcept {
+  clear();
+  if (capacity_) {
+    deallocate_block(data_, capacity_);
+  }
+  data_ = data;
+  invalidate_iterators();
+  size_ = size;
+  capacity_ = capacity;
+  if (capacity_) {
+    Stats::on_allocate(capacity_, sizeof(Type));
+  }
+  Stats::on_storage_change(size_, capacity_);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+const Stats &ekuvector<Type, Allocator, Growth, Stats>::stats() noexcept {
+  Stats::on_storage_change(size_, capacity_);
+  return *this;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::pointer
+ekuvector<Type, Allocator, Growth, Stats>::allocate_block(size_type capacity) {
+  auto block = alloc_traits::allocate(allocator_, capacity);
+  Stats::on_allocate(capacity, sizeof(Type));
+  return block;
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth, Stats>::deallocate_block(
+    pointer block, size_type capacity) noexcept {
+  alloc_traits::deallocate(allocator_, block, capacity);
+  Stats::on_deallocate(capacity, sizeof(Type));
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+Type *ekuvector<Type, Allocator, Growth, Stats>::raw_data() const noexcept {
+  return detail::to_address(data_);
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+void ekuvector<Type, Allocator, Growth,
+               Stats>::invalidate_iterators() noexcept {
+#if defined(EKUVECTOR_CHECKED)
+  ++generation_;
+#endif
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::iterator
+ekuvector<Type, Allocator, Growth, Stats>::make_iterator(
+    Type *address) noexcept {
+#if defined(EKUVECTOR_CHECKED)
+  return iterator(this, address);
+#else
+  return address;
+#endif
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::const_iterator
+ekuvector<Type, Allocator, Growth, Stats>::make_iterator(
+    const Type *address) const noexcept {
+#if defined(EKUVECTOR_CHECKED)
+  return const_iterator(this, address);
+#else
+  return address;
+#endif
+}
+
+template <class Type, class Allocator, class Growth, class Stats>
+typename ekuvector<Type, Allocator, Growth, Stats>::size_type
+ekuvector<Type, Allocator, Growth, Stats>::ordinal_of(
+    const_iterator pos) const noexcept {
+#if defined(EKUVECTOR_CHECKED)
+  EKUVECTOR_CHECK(pos.owner_ == this,
+                  "ekuvector iterator belongs to another container");
+  pos.check_valid();
+  return static_cast<size_type>(pos.address_ - raw_data());
+#else
+  return static_cast<size_type>(pos - raw_data());
+#endif
 }
 
+#if defined(EKUVECTOR_CHECKED)
+
+/** @brief Random access iterator that remembers the container it belongs to
+ *         and the generation of its storage, so that it can tell when the
+ *         elements have moved to another block since it was created.
+ *
+ * Every operation checks that the iterator is still valid and stays within
+ * [begin(), end()], and dereferencing checks that it refers to an element. */
+template <class Type, class Allocator, class Growth, class Stats>
+template <bool Const>
+class ekuvector<Type, Allocator, Growth, Stats>::checked_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      typename std::conditional<Const, const Type &, Type &>::type;
+  using pointer = typename std::conditional<Const, const Type *, Type *>::type;
+
+  checked_iterator() noexcept
+      : owner_{nullptr}, address_{nullptr}, generation_{0} {}
+
+  /* mutable iterators convert to const ones */
+  template <bool OtherConst,
+            class = typename std::enable_if<Const && !OtherConst>::type>
+  checked_iterator(const checked_iterator<OtherConst> &other) noexcept
+      : owner_{other.owner_}, address_{other.address_},
+        generation_{other.generation_} {}
+
+  reference operator*() const noexcept {
+    check_dereferenceable(address_);
+    return *address_;
+  }
+  pointer operator->() const noexcept {
+    check_dereferenceable(address_);
+    return address_;
+  }
+  reference operator[](difference_type offset) const noexcept {
+    check_dereferenceable(address_ + offset);
+    return address_[offset];
+  }
+
+  checked_iterator &operator++() noexcept { return *this += 1; }
+  checked_iterator operator++(int) noexcept {
+    auto previous = *this;
+    *this += 1;
+    return previous;
+  }
+  checked_iterator &operator--() noexcept { return *this -= 1; }
+  checked_iterator operator--(int) noexcept {
+    auto previous = *this;
+    *this -= 1;
+    return previous;
+  }
+  checked_iterator &operator+=(difference_type offset) noexcept {
+    check_valid();
+    address_ += offset;
+    EKUVECTOR_CHECK((owner_->raw_data() <= address_) &&
+                        (address_ <= owner_->raw_data() + owner_->size_),
+                    "ekuvector iterator moved out of range");
+    return *this;
+  }
+  checked_iterator &operator-=(difference_type offset) noexcept {
+    return *this += -offset;
+  }
+  checked_iterator operator+(difference_type offset) const noexcept {
+    auto result = *this;
+    return result += offset;
+  }
+  friend checked_iterator operator+(difference_type offset,
+                                    const checked_iterator &it) noexcept {
+    return it + offset;
+  }
+  checked_iterator operator-(difference_type offset) const noexcept {
+    auto result = *this;
+    return result -= offset;
+  }
+  /* friends, so that mutable and const iterators can be mixed */
+  friend difference_type operator-(const checked_iterator &lhs,
+                                   const checked_iterator &rhs) noexcept {
+    lhs.check_comparable(rhs);
+    return lhs.address_ - rhs.address_;
+  }
+  friend bool operator==(const checked_iterator &lhs,
+                         const checked_iterator &rhs) noexcept {
+    lhs.check_comparable(rhs);
+    return lhs.address_ == rhs.address_;
+  }
+  friend bool operator!=(const checked_iterator &lhs,
+                         const checked_iterator &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+  friend bool operator<(const checked_iterator &lhs,
+                        const checked_iterator &rhs) noexcept {
+    lhs.check_comparable(rhs);
+    return lhs.address_ < rhs.address_;
+  }
+  friend bool operator>(const checked_iterator &lhs,
+                        const checked_iterator &rhs) noexcept {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const checked_iterator &lhs,
+                         const checked_iterator &rhs) noexcept {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const checked_iterator &lhs,
+                         const checked_iterator &rhs) noexcept {
+    return !(lhs < rhs);
+  }
+
+private:
+  template <bool> friend class checked_iterator;
+  friend class ekuvector;
+
+  checked_iterator(const ekuvector *owner, pointer address) noexcept
+      : owner_{owner}, address_{address}, generation_{owner->generation_} {}
+
+  void check_valid() const noexcept {
+    EKUVECTOR_CHECK(owner_ != nullptr, "ekuvector iterator is singular");
+    EKUVECTOR_CHECK(generation_ == owner_->generation_,
+                    "ekuvector iterator used after a reallocation");
+  }
+
+  void check_dereferenceable(pointer address) const noexcept {
+    check_valid();
+    EKUVECTOR_CHECK((owner_->raw_data() <= address) &&
+                        (address < owner_->raw_data() + owner_->size_),
+                    "ekuvector iterator is not dereferenceable");
+  }
+
+  void check_comparable(const checked_iterator &other) const noexcept {
+    check_valid();
+    other.check_valid();
+    EKUVECTOR_CHECK(owner_ == other.owner_,
+                    "ekuvector iterators belong to different containers");
+  }
+
+  const ekuvector *owner_;
+  pointer address_;
+  size_type generation_;
+};
+
+#endif
+
 /*
  * *** NON MEMBERS ***
  * */
 
-template <class Type, class Alloc>
-bool operator==(const ekuvector<Type, Alloc> &lhs,
-                const ekuvector<Type, Alloc> &rhs) {
-  if (lhs.size() != rhs.size()) {
-    return false;
+namespace detail {
+
+/* integers and pointers are equal exactly when their object representations
+   are, which floating point values and class types don't guarantee. Neither
+   do enums, which may overload operator== */
+template <class T>
+using bitwise_equality_tag =
+    std::integral_constant<bool, std::is_integral<T>::value ||
+                                     std::is_pointer<T>::value>;
+
+/* memcmp orders single byte unsigned values the same way operator< does */
+template <class T>
+using bytewise_order_tag =
+    std::integral_constant<bool, std::is_integral<T>::value &&
+                                     std::is_unsigned<T>::value &&
+                                     (sizeof(T) == 1) &&
+                                     !std::is_same<T, bool>::value>;
+
+template <class T>
+bool equal_n(const T *lhs, const T *rhs, std::size_t count, std::true_type) {
+  return (count == 0) || (std::memcmp(lhs, rhs, count * sizeof(T)) == 0);
+}
+
+template <class T>
+bool equal_n(const T *lhs, const T *rhs, std::size_t count, std::false_type) {
+  return std::equal(lhs, lhs + count, rhs);
+}
+
+template <class T>
+bool less_n(const T *lhs, std::size_t lhs_count, const T *rhs,
+            std::size_t rhs_count, std::true_type) {
+  const auto common = std::min(lhs_count, rhs_count);
+  const auto result = (common == 0) ? 0 : std::memcmp(lhs, rhs, common);
+  return (result < 0) || ((result == 0) && (lhs_count < rhs_count));
+}
+
+/* integers can skip the shared prefix in blocks compared with memcmp(), which
+   is vectorized, and then only scan the block holding the first mismatch */
+template <class T>
+bool mismatch_less_n(const T *lhs, std::size_t lhs_count, const T *rhs,
+                     std::size_t rhs_count, std::true_type) {
+  constexpr std::size_t block = (sizeof(T) < 256) ? 256 / sizeof(T) : 1;
+  const auto common = std::min(lhs_count, rhs_count);
+  std::size_t index = 0;
+  while ((index + block <= common) &&
+         (std::memcmp(lhs + index, rhs + index, block * sizeof(T)) == 0)) {
+    index += block;
   }
-
-  auto lit = lhs.begin();
-  auto rit = rhs.begin();
-  for (; lit != lhs.end(); ++lit, ++rit) {
-    if (*lit != *rit) {
-      return false;
+  for (; index < common; ++index) {
+    if (lhs[index] != rhs[index]) {
+      return lhs[index] < rhs[index];
     }
   }
+  return lhs_count < rhs_count;
+}
 
-  return true;
+template <class T>
+bool mismatch_less_n(const T *lhs, std::size_t lhs_count, const T *rhs,
+                     std::size_t rhs_count, std::false_type) {
+  return std::lexicographical_compare(lhs, lhs + lhs_count, rhs,
+                                      rhs + rhs_count);
 }
 
-template <class Type, class Alloc>
-bool operator!=(const ekuvector<Type, Alloc> &lhs,
-                const ekuvector<Type, Alloc> &rhs) {
-  return !(lhs == rhs);
+template <class T>
+bool less_n(const T *lhs, std::size_t lhs_count, const T *rhs,
+            std::size_t rhs_count, std::false_type) {
+  return mismatch_less_n(lhs, lhs_count, rhs, rhs_count,
+                         bitwise_equality_tag<T>{});
 }
 
-template <class Type, class Alloc>
-bool operator<(const ekuvector<Type, Alloc> &lhs,
-               const ekuvector<Type, Alloc> &rhs) {
-  auto lit = lhs.cbegin();
-  auto rit = rhs.cbegin();
+/* contents comparisons shared by the ekuvector family of containers */
 
-  while ((lit != lhs.cend()) && (rit != rhs.cend())) {
-    if (*lit < *rit) {
-      return true;
-    }
-    if (*rit < *lit) {
-      return false;
-    }
+template <class T>
+bool equal_contents(const T *lhs, std::size_t lhs_count, const T *rhs,
+                    std::size_t rhs_count) {
+  return (lhs_count == rhs_count) &&
+         equal_n(lhs, rhs, lhs_count, bitwise_equality_tag<T>{});
+}
 
-    ++lit;
-    ++rit;
-  }
-  return (lit == lhs.cend()) && (rit != rhs.cend());
+template <class T>
+bool less_contents(const T *lhs, std::size_t lhs_count, const T *rhs,
+                   std::size_t rhs_count) {
+  return less_n(lhs, lhs_count, rhs, rhs_count, bytewise_order_tag<T>{});
+}
+
+}; // namespace detail
+
+template <class Type, class Alloc, class Growth, class Stats>
+bool operator==(const ekuvector<Type, Alloc, Growth, Stats> &lhs,
+                const ekuvector<Type, Alloc, Growth, Stats> &rhs) {
+  return detail::equal_contents(lhs.data(), lhs.size(), rhs.data(),
+                                rhs.size());
 }
 
-template <class Type, class Alloc>
-bool operator<=(const ekuvector<Type, Alloc> &lhs,
-                const ekuvector<Type, Alloc> &rhs) {
-  return ((lhs < rhs) || (lhs == rhs));
+template <class Type, class Alloc, class Growth, class Stats>
+bool operator!=(const ekuvector<Type, Alloc, Growth, Stats> &lhs,
+                const ekuvector<Type, Alloc, Growth, Stats> &rhs) {
+  return !(lhs == rhs);
 }
 
-template <class Type, class Alloc>
-bool operator>(const ekuvector<Type, Alloc> &lhs,
-               const ekuvector<Type, Alloc> &rhs) {
-  return !(lhs <= rhs);
+template <class Type, class Alloc, class Growth, class Stats>
+bool operator<(const ekuvector<Type, Alloc, Growth, Stats> &lhs,
+               const ekuvector<Type, Alloc, Growth, Stats> &rhs) {
+  return detail::less_contents(lhs.data(), lhs.size(), rhs.data(),
+                               rhs.size());
 }
 
-template <class Type, class Alloc>
-bool operator>=(const ekuvector<Type, Alloc> &lhs,
-                const ekuvector<Type, Alloc> &rhs) {
+template <class Type, class Alloc, class Growth, class Stats>
+bool operator<=(const ekuvector<Type, Alloc, Growth, Stats> &lhs,
+                const ekuvector<Type, Alloc, Growth, Stats> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <class Type, class Alloc, class Growth, class Stats>
+bool operator>(const ekuvector<Type, Alloc, Growth, Stats> &lhs,
+               const ekuvector<Type, Alloc, Growth, Stats> &rhs) {
+  return rhs < lhs;
+}
+
+template <class Type, class Alloc, class Growth, class Stats>
+bool operator>=(const ekuvector<Type, Alloc, Growth, Stats> &lhs,
+                const ekuvector<Type, Alloc, Growth, Stats> &rhs) {
   return !(lhs < rhs);
 }
 
-template <class Type, class Alloc>
-void swap(ekuvector<Type, Alloc> &lhs, ekuvector<Type, Alloc> &rhs) {
+/** @brief Erases every element that compares equal to value, and returns the
+ *         number of erased elements. */
+template <class Type, class Alloc, class Growth, class Stats, class Value>
+typename ekuvector<Type, Alloc, Growth, Stats>::size_type
+erase(ekuvector<Type, Alloc, Growth, Stats> &container, const Value &value) {
+  return container.erase_if(
+      [&value](const Type &item) { return item == value; });
+}
+
+/** @brief Erases every element for which pred returns true, and returns the
+ *         number of erased elements. */
+template <class Type, class Alloc, class Growth, class Stats, class Predicate>
+typename ekuvector<Type, Alloc, Growth, Stats>::size_type
+erase_if(ekuvector<Type, Alloc, Growth, Stats> &container, Predicate pred) {
+  return container.erase_if(pred);
+}
+
+template <class Type, class Alloc, class Growth, class Stats>
+void swap(ekuvector<Type, Alloc, Growth, Stats> &lhs,
+          ekuvector<Type, Alloc, Growth, Stats> &rhs) noexcept {
   lhs.swap(rhs);
 }
 
@@ -0,0 +1,416 @@
+/**
+ * ekuarena_allocator, ekupool_allocator, ekualigned_allocator and
+ * allocator_traits support.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekualigned_allocator.hpp>
+#include <ekuvector/ekuarena_allocator.hpp>
+#include <ekuvector/ekupool_allocator.hpp>
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* pointer-like wrapper, standing in for offset or shared memory pointers */
+template <class Type> class FancyPtr {
+public:
+  using element_type = Type;
+
+  FancyPtr() noexcept : raw_{nullptr} {}
+  FancyPtr(std::nullptr_t) noexcept : raw_{nullptr} {}
+  explicit FancyPtr(Type *raw) noexcept : raw_{raw} {}
+
+  Type *operator->() const noexcept { return raw_; }
+  Type &operator*() const noexcept { return *raw_; }
+
+  bool operator==(const FancyPtr &other) const noexcept {
+    return raw_ == other.raw_;
+  }
+  bool operator!=(const FancyPtr &other) const noexcept {
+    return raw_ != other.raw_;
+  }
+
+private:
+  Type *raw_;
+};
+
+/* minimal allocator handing out fancy pointers, with no construct() or
+   destroy() members of its own */
+template <class Type> class FancyAllocator {
+public:
+  using value_type = Type;
+  using pointer = FancyPtr<Type>;
+
+  FancyAllocator() = default;
+  template <class Other> FancyAllocator(const FancyAllocator<Other> &) {}
+
+  pointer allocate(std::size_t n) {
+    ++live_blocks_;
+    return pointer(std::allocator<Type>().allocate(n));
+  }
+
+  void deallocate(pointer p, std::size_t n) {
+    --live_blocks_;
+    std::allocator<Type>().deallocate(p.operator->(), n);
+  }
+
+  static int32_t live_blocks_;
+};
+
+template <class Type> int32_t FancyAllocator<Type>::live_blocks_ = 0;
+
+template <class Type, class Other>
+bool operator==(const FancyAllocator<Type> &, const FancyAllocator<Other> &) {
+  return true;
+}
+
+template <class Type, class Other>
+bool operator!=(const FancyAllocator<Type> &, const FancyAllocator<Other> &) {
+  return false;
+}
+
+/* allocator that customizes element construction and destruction */
+template <class Type> class ConstructCountingAllocator {
+public:
+  using value_type = Type;
+
+  ConstructCountingAllocator() = default;
+  template <class Other>
+  ConstructCountingAllocator(const ConstructCountingAllocator<Other> &) {}
+
+  Type *allocate(std::size_t n) { return std::allocator<Type>().allocate(n); }
+
+  void deallocate(Type *p, std::size_t n) {
+    std::allocator<Type>().deallocate(p, n);
+  }
+
+  template <class Other, class... Args>
+  void construct(Other *p, Args &&... args) {
+    ++constructed_;
+    ::new (static_cast<void *>(p)) Other(std::forward<Args>(args)...);
+  }
+
+  template <class Other> void destroy(Other *p) {
+    ++destroyed_;
+    p->~Other();
+  }
+
+  static int32_t constructed_;
+  static int32_t destroyed_;
+};
+
+template <class Type>
+int32_t ConstructCountingAllocator<Type>::constructed_ = 0;
+template <class Type> int32_t ConstructCountingAllocator<Type>::destroyed_ = 0;
+
+template <class Type, class Other>
+bool operator==(const ConstructCountingAllocator<Type> &,
+                const ConstructCountingAllocator<Other> &) {
+  return true;
+}
+
+template <class Type, class Other>
+bool operator!=(const ConstructCountingAllocator<Type> &,
+                const ConstructCountingAllocator<Other> &) {
+  return false;
+}
+
+/* allocator backed by malloc(), which can resize blocks with realloc() */
+template <class Type> class ReallocatingAllocator {
+public:
+  using value_type = Type;
+
+  ReallocatingAllocator() = default;
+  template <class Other>
+  ReallocatingAllocator(const ReallocatingAllocator<Other> &) {}
+
+  Type *allocate(std::size_t n) {
+    ++allocations_;
+    return static_cast<Type *>(std::malloc(n * sizeof(Type)));
+  }
+
+  void deallocate(Type *p, std::size_t /* n */) { std::free(p); }
+
+  Type *reallocate(Type *p, std::size_t /* old_n */, std::size_t new_n) {
+    ++reallocations_;
+    return static_cast<Type *>(std::realloc(p, new_n * sizeof(Type)));
+  }
+
+  static int32_t allocations_;
+  static int32_t reallocations_;
+};
+
+template <class Type> int32_t ReallocatingAllocator<Type>::allocations_ = 0;
+template <class Type> int32_t ReallocatingAllocator<Type>::reallocations_ = 0;
+
+template <class Type, class Other>
+bool operator==(const ReallocatingAllocator<Type> &,
+                const ReallocatingAllocator<Other> &) {
+  return true;
+}
+
+template <class Type, class Other>
+bool operator!=(const ReallocatingAllocator<Type> &,
+                const ReallocatingAllocator<Other> &) {
+  return false;
+}
+
+} // namespace
+
+class EkuAllocatorTests : public testing::Test {};
+
+class ArenaAllocatorTests : public EkuAllocatorTests {};
+
+TEST_F(ArenaAllocatorTests, ServesFromTheUserBuffer) {
+  alignas(std::max_align_t) char buffer[16 * 1024];
+  ekuarena arena(buffer, sizeof(buffer));
+  {
+    ekuvector<int32_t, ekuarena_allocator<int32_t>> uut(arena);
+    for (int32_t i = 0; i < 1000; ++i) {
+      uut.push_back(i);
+    }
+    ASSERT_EQ(1000, uut.size());
+    EXPECT_EQ(999, uut.back());
+    // growth keeps rolling back the top of the arena, so everything fits
+    EXPECT_EQ(0, arena.chunk_count());
+    EXPECT_GE(static_cast<void *>(uut.data()), static_cast<void *>(buffer));
+    EXPECT_LT(static_cast<void *>(uut.data()),
+              static_cast<void *>(buffer + sizeof(buffer)));
+  }
+}
+
+TEST_F(ArenaAllocatorTests, GrowsIntoTheHeapAndReleasesInBulk) {
+  ekuarena arena(256);
+  ekuvector<std::string, ekuarena_allocator<std::string>> first(arena);
+  ekuvector<std::string, ekuarena_allocator<std::string>> second(arena);
+  for (int32_t i = 0; i < 100; ++i) {
+    first.push_back(std::to_string(i));
+    second.push_back(std::to_string(-i));
+  }
+  EXPECT_EQ("99", first.back());
+  EXPECT_EQ("-99", second.back());
+  EXPECT_LT(0, arena.chunk_count());
+  first.clear();
+  second.clear();
+  first.shrink_to_fit();
+  second.shrink_to_fit();
+  arena.release();
+  EXPECT_EQ(0, arena.chunk_count());
+}
+
+TEST_F(ArenaAllocatorTests, MovesWithinAnArenaHandOverStorage) {
+  ekuarena arena;
+  ekuarena other_arena;
+  using ArenaVector = ekuvector<std::string, ekuarena_allocator<std::string>>;
+
+  ArenaVector source({"a", "b", "c"}, arena);
+  const auto source_data = source.data();
+  ArenaVector moved(std::move(source), ekuarena_allocator<std::string>(arena));
+  EXPECT_EQ(source_data, moved.data());
+  EXPECT_TRUE(source.empty());
+
+  // storage can't be handed over to a container using another arena
+  ArenaVector other(other_arena);
+  other = std::move(moved);
+  EXPECT_NE(source_data, other.data());
+  ASSERT_EQ(3, other.size());
+  EXPECT_EQ("c", other[2]);
+  EXPECT_TRUE(&other.get_allocator().arena() == &other_arena);
+}
+
+class PoolAllocatorTests : public EkuAllocatorTests {};
+
+TEST_F(PoolAllocatorTests, ReusesReleasedBlocks) {
+  ekupool pool;
+  using PoolVector = ekuvector<int64_t, ekupool_allocator<int64_t>>;
+  const int64_t *first_data = nullptr;
+  {
+    PoolVector uut(pool);
+    uut.reserve(100);
+    first_data = uut.data();
+  }
+  const auto slabs = pool.slab_count();
+  PoolVector uut(pool);
+  uut.reserve(128);
+  // same size class as the block released above
+  EXPECT_EQ(first_data, uut.data());
+  EXPECT_EQ(slabs, pool.slab_count());
+}
+
+TEST_F(PoolAllocatorTests, GrowthAndLargeBlocks) {
+  ekupool pool;
+  ekuvector<std::string, ekupool_allocator<std::string>> uut(pool);
+  for (int32_t i = 0; i < 10000; ++i) {
+    uut.push_back(std::to_string(i));
+  }
+  ASSERT_EQ(10000, uut.size());
+  EXPECT_EQ("9999", uut.back());
+  EXPECT_TRUE(uut.get_allocator() ==
+              ekupool_allocator<int32_t>(uut.get_allocator()));
+}
+
+class AlignedAllocatorTests : public EkuAllocatorTests {};
+
+TEST_F(AlignedAllocatorTests, DataIsAlignedAcrossGrowth) {
+  ekualigned_vector<float, 64> uut;
+  for (int32_t i = 0; i < 1000; ++i) {
+    uut.push_back(static_cast<float>(i));
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(uut.data()) % 64);
+  }
+  EXPECT_EQ(999.0f, uut.back());
+
+  ekualigned_vector<double, 32> copy(uut.begin(), uut.end());
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(copy.data()) % 32);
+  EXPECT_EQ(999.0, copy.back());
+}
+
+TEST_F(AlignedAllocatorTests, CapacityFillsWholeVectorLanes) {
+  ekualigned_vector<float, 64> uut;
+  uut.reserve(1);
+  EXPECT_EQ(16u, uut.capacity());
+  uut.resize(17);
+  EXPECT_EQ(0u, uut.capacity() % 16);
+  uut.resize(33);
+  uut.shrink_to_fit();
+  EXPECT_EQ(48u, uut.capacity());
+
+  ekualigned_vector<double, 32> doubles(5);
+  EXPECT_EQ(8u, doubles.capacity());
+}
+
+TEST_F(AlignedAllocatorTests, OverAlignedStorageForAnyType) {
+  ekuvector<std::string, ekualigned_allocator<std::string, 128>> uut;
+  for (int32_t i = 0; i < 100; ++i) {
+    uut.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(uut.data()) % 128);
+  EXPECT_EQ("99", uut.back());
+}
+
+class AllocatorTraitsTests : public EkuAllocatorTests {};
+
+TEST_F(AllocatorTraitsTests, FancyPointers) {
+  {
+    using FancyVector = ekuvector<std::string, FancyAllocator<std::string>>;
+    static_assert(std::is_same<FancyPtr<std::string>,
+                               FancyVector::pointer>::value,
+                  "pointer must come from the allocator");
+    FancyVector uut;
+    for (int32_t i = 0; i < 100; ++i) {
+      uut.push_back(std::to_string(i));
+    }
+    uut.insert(uut.begin(), "first");
+    uut.erase(uut.begin() + 1, uut.begin() + 11);
+    ASSERT_EQ(91, uut.size());
+    EXPECT_EQ("first", uut.front());
+    EXPECT_EQ("10", uut[1]);
+
+    FancyVector copy(uut);
+    EXPECT_TRUE(copy == uut);
+    FancyVector moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ("99", moved.back());
+    moved.swap(uut);
+    uut.clear();
+    uut.shrink_to_fit();
+    EXPECT_EQ(0, uut.capacity());
+    EXPECT_EQ(1, FancyAllocator<std::string>::live_blocks_);
+  }
+  {
+    ekuvector<int32_t, FancyAllocator<int32_t>> uut(10, 7);
+    uut.resize(20);
+    uut.assign({1, 2, 3});
+    ASSERT_EQ(3, uut.size());
+    EXPECT_EQ(3, uut[2]);
+  }
+  EXPECT_EQ(0, FancyAllocator<std::string>::live_blocks_);
+  EXPECT_EQ(0, FancyAllocator<int32_t>::live_blocks_);
+}
+
+TEST_F(AllocatorTraitsTests, CustomConstructAndDestroyAreHonoured) {
+  using Counter = ConstructCountingAllocator<int32_t>;
+  Counter::constructed_ = 0;
+  Counter::destroyed_ = 0;
+  {
+    ekuvector<int32_t, Counter> uut(4, 1);
+    uut.push_back(2);
+    uut.resize(8);
+    EXPECT_EQ(8, Counter::constructed_ - Counter::destroyed_);
+    ekuvector<int32_t, Counter> copy(uut);
+    EXPECT_EQ(16, Counter::constructed_ - Counter::destroyed_);
+    uut.erase(uut.begin(), uut.begin() + 2);
+    uut.pop_back();
+  }
+  EXPECT_LT(16, Counter::constructed_);
+  EXPECT_EQ(Counter::constructed_, Counter::destroyed_);
+}
+
+TEST_F(AllocatorTraitsTests, MaxSizeComesFromTheAllocator) {
+  ekuvector<int64_t> uut;
+  EXPECT_EQ(std::allocator_traits<std::allocator<int64_t>>::max_size(
+                uut.get_allocator()),
+            uut.max_size());
+}
+
+TEST_F(AllocatorTraitsTests, BlocksGrowThroughReallocate) {
+  using Ints = ReallocatingAllocator<int32_t>;
+  Ints::allocations_ = 0;
+  Ints::reallocations_ = 0;
+  {
+    ekuvector<int32_t, Ints> uut;
+    for (int32_t i = 0; i < 1000; ++i) {
+      uut.push_back(i);
+    }
+    EXPECT_EQ(1, Ints::allocations_);
+    EXPECT_LT(0, Ints::reallocations_);
+
+    // arguments and ranges coming from the container itself
+    uut.shrink_to_fit();
+    uut.emplace(uut.begin(), uut.back());
+    uut.shrink_to_fit();
+    uut.insert(uut.begin() + 1, uut.end() - 2, uut.end());
+    ASSERT_EQ(1003, uut.size());
+    EXPECT_EQ(999, uut[0]);
+    EXPECT_EQ(998, uut[1]);
+    EXPECT_EQ(999, uut[2]);
+    EXPECT_EQ(0, uut[3]);
+    EXPECT_EQ(999, uut.back());
+
+    // other ranges are copied straight into the gap
+    const int32_t more[] = {7, 8};
+    uut.shrink_to_fit();
+    uut.insert(uut.begin() + 1, std::begin(more), std::end(more));
+    ASSERT_EQ(1005, uut.size());
+    EXPECT_EQ(999, uut[0]);
+    EXPECT_EQ(7, uut[1]);
+    EXPECT_EQ(8, uut[2]);
+    EXPECT_EQ(998, uut[3]);
+    EXPECT_EQ(1, Ints::allocations_);
+  }
+
+  // elements that can't be relocated bytewise get moved one by one
+  using Strings = ReallocatingAllocator<std::string>;
+  ekuvector<std::string, Strings> strings;
+  for (int32_t i = 0; i < 100; ++i) {
+    strings.push_back(std::to_string(i));
+  }
+  EXPECT_EQ("99", strings.back());
+  EXPECT_LT(1, Strings::allocations_);
+  EXPECT_EQ(0, Strings::reallocations_);
+}
+
+}; // namespace ekustd
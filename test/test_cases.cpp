@@ -5,8 +5,15 @@
 
 // Standard library
 #include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // gtest and gmock
 #include "gtest/gtest.h"
@@ -27,7 +34,7 @@ public:
     ++copy_ops_;
     value_ = other.value_;
   }
-  IChar(IChar &&other) {
+  IChar(IChar &&other) noexcept {
     ++move_ops_;
     value_ = other.value_;
   }
@@ -36,7 +43,7 @@ public:
     value_ = other.value_;
     return *this;
   }
-  IChar &operator=(IChar &&other) {
+  IChar &operator=(IChar &&other) noexcept {
     ++move_ops_;
     value_ = other.value_;
     return *this;
@@ -63,6 +70,138 @@ int32_t IChar::value_constructor_;
 int32_t IChar::copy_ops_;
 int32_t IChar::move_ops_;
 
+struct PackedRecord {
+  int32_t id;
+  float weight;
+  char tag;
+};
+
+bool operator==(const PackedRecord &lhs, const PackedRecord &rhs) {
+  return (lhs.id == rhs.id) && (lhs.weight == rhs.weight) &&
+         (lhs.tag == rhs.tag);
+}
+
+bool operator!=(const PackedRecord &lhs, const PackedRecord &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+/* Allocator that counts the blocks requested and returned through it */
+template <class T> class CountingAllocator : public std::allocator<T> {
+public:
+  template <class U> struct rebind { using other = CountingAllocator<U>; };
+
+  CountingAllocator() = default;
+  template <class U> CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(std::size_t count) {
+    ++allocations_;
+    return std::allocator<T>::allocate(count);
+  }
+  void deallocate(T *block, std::size_t count) {
+    ++deallocations_;
+    std::allocator<T>::deallocate(block, count);
+  }
+
+  static void reset() {
+    allocations_ = 0;
+    deallocations_ = 0;
+  }
+
+  static int32_t allocations_;
+  static int32_t deallocations_;
+};
+
+template <class T> int32_t CountingAllocator<T>::allocations_ = 0;
+template <class T> int32_t CountingAllocator<T>::deallocations_ = 0;
+
+/* Element whose move may throw, and whose copies start failing once
+ * copies_left_ runs out */
+class FragileCopy {
+public:
+  FragileCopy(int32_t value) : value_{value} {}
+  FragileCopy(const FragileCopy &other) : value_{other.value_} {
+    if (copies_left_ == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    --copies_left_;
+  }
+  FragileCopy(FragileCopy &&other) : value_{other.value_} { ++moves_; }
+  FragileCopy &operator=(const FragileCopy &other) = default;
+
+  int32_t value() const { return value_; }
+
+  static int32_t copies_left_;
+  static int32_t moves_;
+
+private:
+  int32_t value_;
+};
+
+int32_t FragileCopy::copies_left_ = 0;
+int32_t FragileCopy::moves_ = 0;
+
+/* Element whose moves start failing once moves_left_ runs out, while its
+ * copies always succeed */
+class FragileMove {
+public:
+  FragileMove(int32_t value) : value_{value} {}
+  FragileMove(const FragileMove &other) = default;
+  FragileMove(FragileMove &&other) : value_{other.value_} {
+    if (moves_left_ == 0) {
+      throw std::runtime_error("move failed");
+    }
+    --moves_left_;
+  }
+  FragileMove &operator=(const FragileMove &other) = default;
+
+  int32_t value() const { return value_; }
+
+  static int32_t moves_left_;
+
+private:
+  int32_t value_;
+};
+
+int32_t FragileMove::moves_left_ = 0;
+
+/* enum whose equality ignores the flag bit */
+enum class Flagged : uint8_t { flag = 0x80 };
+
+bool operator==(Flagged lhs, Flagged rhs) {
+  return ((static_cast<uint8_t>(lhs) ^ static_cast<uint8_t>(rhs)) & 0x7f) == 0;
+}
+
+bool operator!=(Flagged lhs, Flagged rhs) { return !(lhs == rhs); }
+
+/* Stateful allocator that doesn't follow the containers on move assignment,
+ * so that blocks can only be handed over between equal instances */
+template <class T> class TaggedAllocator : public std::allocator<T> {
+public:
+  using propagate_on_container_move_assignment = std::false_type;
+  using is_always_equal = std::false_type;
+
+  template <class U> struct rebind { using other = TaggedAllocator<U>; };
+
+  explicit TaggedAllocator(int32_t tag = 0) : tag_{tag} {}
+  template <class U>
+  TaggedAllocator(const TaggedAllocator<U> &other) : tag_{other.tag_} {}
+
+  int32_t tag_;
+};
+
+template <class T, class U>
+bool operator==(const TaggedAllocator<T> &lhs, const TaggedAllocator<U> &rhs) {
+  return lhs.tag_ == rhs.tag_;
+}
+
+template <class T, class U>
+bool operator!=(const TaggedAllocator<T> &lhs, const TaggedAllocator<U> &rhs) {
+  return !(lhs == rhs);
+}
+
 class EkuVectorTests : public testing::Test {};
 
 class ConstructorTests : public EkuVectorTests {};
@@ -254,7 +393,35 @@ TEST_F(AssignmentTests, MoveAssignment) {
     instrumented_uut = std::move(source);
     EXPECT_EQ(0, IChar::value_constructor_);
     EXPECT_EQ(0, IChar::copy_ops_);
+    EXPECT_EQ(0, IChar::move_ops_);
+    EXPECT_EQ(3, instrumented_uut.size());
+    EXPECT_EQ(0, source.size());
+  }
+}
+
+TEST_F(AssignmentTests, MoveAssignmentWithAllocators) {
+  using TaggedVector = ekuvector<IChar, TaggedAllocator<IChar>>;
+  {
+    TaggedVector source({'a', 'b', 'c'}, TaggedAllocator<IChar>{1});
+    TaggedVector uut({'d'}, TaggedAllocator<IChar>{1});
+    const auto source_data = source.data();
+    IChar::reset();
+    uut = std::move(source);
+    EXPECT_EQ(source_data, uut.data());
+    EXPECT_EQ(0, IChar::move_ops_);
+    EXPECT_EQ(3, uut.size());
+    EXPECT_EQ(0, source.size());
+  }
+  {
+    TaggedVector source({'a', 'b', 'c'}, TaggedAllocator<IChar>{1});
+    TaggedVector uut({'d'}, TaggedAllocator<IChar>{2});
+    uut.reserve(3);
+    IChar::reset();
+    uut = std::move(source);
+    EXPECT_EQ(2, uut.get_allocator().tag_);
+    EXPECT_EQ(0, IChar::copy_ops_);
     EXPECT_EQ(3, IChar::move_ops_);
+    EXPECT_EQ(3, uut.size());
   }
 }
 
@@ -282,6 +449,27 @@ TEST_F(AssignmentTests, InitializerListAssignment) {
   EXPECT_EQ("99", uut_obj[2]);
 }
 
+TEST_F(AssignmentTests, CopyAssignmentReusesElements) {
+  ekuvector<IChar> source({'a', 'b', 'c'});
+  ekuvector<IChar> instrumented_uut({'d', 'e', 'f', 'g'});
+  const auto uut_data = instrumented_uut.data();
+  IChar::reset();
+  instrumented_uut = source;
+  EXPECT_EQ(uut_data, instrumented_uut.data());
+  EXPECT_EQ(3, instrumented_uut.size());
+  EXPECT_EQ(0, IChar::default_constructor_);
+  EXPECT_EQ(3, IChar::copy_ops_);
+  EXPECT_EQ(0, IChar::move_ops_);
+
+  ekuvector<int32_t> pod_source({1, 2, 3, 4, 5});
+  ekuvector<int32_t> pod_uut({6, 7});
+  pod_uut.reserve(5);
+  const auto pod_data = pod_uut.data();
+  pod_uut = pod_source;
+  EXPECT_EQ(pod_data, pod_uut.data());
+  EXPECT_TRUE(pod_uut == pod_source);
+}
+
 class AssignMethodTests : public EkuVectorTests {};
 
 TEST_F(AssignMethodTests, AssignValueSmallerThanOriginal) {
@@ -291,15 +479,13 @@ TEST_F(AssignMethodTests, AssignValueSmallerThanOriginal) {
   uut_pod.assign(2, 42);
   uut_obj.assign(2, "42");
 
-  ASSERT_EQ(3, uut_pod.size());
+  ASSERT_EQ(2, uut_pod.size());
   EXPECT_EQ(42, uut_pod[0]);
   EXPECT_EQ(42, uut_pod[1]);
-  EXPECT_EQ(99, uut_pod[2]);
 
-  ASSERT_EQ(3, uut_obj.size());
+  ASSERT_EQ(2, uut_obj.size());
   EXPECT_EQ("42", uut_obj[0]);
   EXPECT_EQ("42", uut_obj[1]);
-  EXPECT_EQ("99", uut_obj[2]);
 }
 
 TEST_F(AssignMethodTests, AssignValueLargerThanOriginal) {
@@ -772,6 +958,36 @@ TEST_F(StorageManagementTests, CapacityAndReserveMembers) {
   };
 }
 
+TEST_F(StorageManagementTests, ShrinkToFit) {
+  {
+    ekuvector<int32_t> uut({97, 98, 99});
+    uut.reserve(100);
+    uut.shrink_to_fit();
+    EXPECT_EQ(3, uut.capacity());
+    EXPECT_EQ(ekuvector<int32_t>({97, 98, 99}), uut);
+    uut.clear();
+    uut.shrink_to_fit();
+    EXPECT_EQ(0, uut.capacity());
+    EXPECT_EQ(nullptr, uut.data());
+  }
+  {
+    ekuvector<std::string> uut({"97", "98", "99"});
+    uut.reserve(100);
+    uut.shrink_to_fit();
+    EXPECT_EQ(3, uut.capacity());
+    EXPECT_EQ(ekuvector<std::string>({"97", "98", "99"}), uut);
+  }
+  {
+    // the capacity can't go below the growth policy's minimum bucket
+    ekuvector<int32_t, std::allocator<int32_t>, additive_growth<16>> uut;
+    uut.resize(40);
+    uut.reserve(100);
+    uut.shrink_to_fit();
+    EXPECT_EQ(48, uut.capacity());
+    EXPECT_EQ(40, uut.size());
+  }
+}
+
 TEST_F(StorageManagementTests, ClearOperation) {
   {
     ekuvector<int32_t> uut({97, 98, 99});
@@ -792,6 +1008,60 @@ TEST_F(StorageManagementTests, ClearOperation) {
   };
 }
 
+TEST_F(StorageManagementTests, ClearAndResizeDestroyElements) {
+  auto canary = std::make_shared<int32_t>(42);
+  {
+    ekuvector<std::shared_ptr<int32_t>> uut(10, canary);
+    EXPECT_EQ(11, canary.use_count());
+    uut.resize(4);
+    EXPECT_EQ(4, uut.size());
+    EXPECT_EQ(5, canary.use_count());
+    uut.clear();
+    EXPECT_TRUE(uut.empty());
+    EXPECT_EQ(1, canary.use_count());
+    uut.resize(3, canary);
+    EXPECT_EQ(4, canary.use_count());
+  }
+  // the destructor releases whatever is left
+  EXPECT_EQ(1, canary.use_count());
+}
+
+TEST_F(StorageManagementTests, ResizeModes) {
+  {
+    ekuvector<IChar> uut;
+    IChar::reset();
+    uut.resize(5);
+    EXPECT_EQ(5, uut.size());
+    // elements are value-initialized in place, with no temporaries
+    EXPECT_EQ(5, IChar::default_constructor_);
+    EXPECT_EQ(0, IChar::copy_ops_);
+    uut.resize_default_init(8);
+    EXPECT_EQ(8, uut.size());
+    EXPECT_EQ(8, IChar::default_constructor_);
+  }
+  {
+    ekuvector<int32_t> uut({1, 2});
+    uut.resize(4);
+    ASSERT_EQ(4, uut.size());
+    EXPECT_EQ(0, uut[2]);
+    EXPECT_EQ(0, uut[3]);
+    // the values of the new elements are indeterminate, but leave the old
+    // ones alone
+    uut.resize_default_init(1000);
+    ASSERT_EQ(1000, uut.size());
+    EXPECT_EQ(1, uut[0]);
+    EXPECT_EQ(2, uut[1]);
+    uut.resize_default_init(1);
+    EXPECT_EQ(1, uut.size());
+  }
+  {
+    // the value can be an element of the same container
+    ekuvector<std::string> uut({"value"});
+    uut.resize(uut.capacity() + 1, uut[0]);
+    EXPECT_EQ("value", uut.back());
+  }
+}
+
 class InsertTests : public EkuVectorTests {};
 
 TEST_F(InsertTests, CopyInsert) {
@@ -940,6 +1210,81 @@ TEST_F(InsertTests, MultipleInsert) {
   };
 }
 
+TEST_F(InsertTests, MultipleInsertOfItsOwnElement) {
+  ekuvector<std::string> uut{"a", "b", "c"};
+  uut.reserve(8);
+  uut.insert(uut.begin(), 2, uut[2]);
+  EXPECT_EQ(ekuvector<std::string>({"c", "c", "a", "b", "c"}), uut);
+
+  uut.shrink_to_fit();
+  uut.insert(uut.begin() + 1, 3, uut[2]);
+  EXPECT_EQ(ekuvector<std::string>({"c", "a", "a", "a", "c", "a", "b", "c"}),
+            uut);
+}
+
+TEST_F(InsertTests, FailedMultipleInsertLeavesContentsIntact) {
+  ekuvector<FragileCopy> uut;
+  uut.reserve(8);
+  uut.emplace_back(1);
+  uut.emplace_back(2);
+  uut.emplace_back(3);
+
+  // the second copy into the gap fails
+  FragileCopy::copies_left_ = 2;
+  EXPECT_THROW(uut.insert(uut.begin(), 3, FragileCopy(9)), std::runtime_error);
+  ASSERT_EQ(3, uut.size());
+  EXPECT_EQ(1, uut[0].value());
+  EXPECT_EQ(3, uut[2].value());
+
+  // the second copy into a new block fails
+  FragileCopy::copies_left_ = 3;
+  uut.shrink_to_fit();
+  const auto data = uut.data();
+  FragileCopy::copies_left_ = 2;
+  EXPECT_THROW(uut.insert(uut.begin() + 1, 3, FragileCopy(9)),
+               std::runtime_error);
+  EXPECT_EQ(data, uut.data());
+  EXPECT_EQ(3, uut.capacity());
+
+  // the elements can't be moved without throwing, so they are copied into
+  // the new block, and the second of those copies fails
+  FragileCopy::copies_left_ = 5;
+  EXPECT_THROW(uut.insert(uut.begin() + 1, 3, FragileCopy(9)),
+               std::runtime_error);
+  EXPECT_EQ(data, uut.data());
+  ASSERT_EQ(3, uut.size());
+  EXPECT_EQ(2, uut[1].value());
+
+  FragileCopy::copies_left_ = 7;
+  uut.insert(uut.begin() + 1, 3, FragileCopy(9));
+  ASSERT_EQ(6, uut.size());
+  EXPECT_EQ(9, uut[3].value());
+  EXPECT_EQ(2, uut[4].value());
+  FragileCopy::copies_left_ = 0;
+}
+
+TEST_F(InsertTests, MultipleInsertDoesNotShiftFragileMoves) {
+  ekuvector<FragileMove> uut;
+  uut.reserve(16);
+  for (int32_t value = 0; value < 5; ++value) {
+    uut.emplace_back(value);
+  }
+
+  // shifting the tail would fail on its third move, so the elements are
+  // copied to a new block of the same size instead
+  FragileMove::moves_left_ = 2;
+  uut.insert(uut.begin(), 2, FragileMove(9));
+  const FragileMove more[] = {7, 8};
+  uut.insert(uut.begin() + 1, std::begin(more), std::end(more));
+  EXPECT_EQ(16, uut.capacity());
+  const std::vector<int32_t> expected = {9, 7, 8, 9, 0, 1, 2, 3, 4};
+  ASSERT_EQ(expected.size(), uut.size());
+  for (std::size_t index = 0; index < expected.size(); ++index) {
+    EXPECT_EQ(expected[index], uut[index].value());
+  }
+  FragileMove::moves_left_ = 0;
+}
+
 TEST_F(InsertTests, InsertThroughIterators) {
   {
     const std::vector<int32_t> sub_seq(2, 42);
@@ -980,6 +1325,22 @@ TEST_F(InsertTests, InsertThroughIterators) {
   };
 }
 
+TEST_F(InsertTests, InsertRangeOfItsOwnElements) {
+  ekuvector<std::string> uut{"a", "b", "c"};
+  uut.reserve(16);
+  uut.insert(uut.begin(), uut.begin(), uut.end());
+  EXPECT_EQ(ekuvector<std::string>({"a", "b", "c", "a", "b", "c"}), uut);
+  uut.insert(uut.begin() + 1, uut.rbegin(), uut.rbegin() + 2);
+  EXPECT_EQ(
+      ekuvector<std::string>({"a", "c", "b", "b", "c", "a", "b", "c"}), uut);
+
+  uut.shrink_to_fit();
+  uut.insert(uut.end(), uut.begin(), uut.begin() + 2);
+  EXPECT_EQ(ekuvector<std::string>(
+                {"a", "c", "b", "b", "c", "a", "b", "c", "a", "c"}),
+            uut);
+}
+
 TEST_F(InsertTests, InsertFromInitializerList) {
   {
     const std::initializer_list<int32_t> sub_seq = {42, 42};
@@ -1020,6 +1381,45 @@ TEST_F(InsertTests, InsertFromInitializerList) {
   };
 }
 
+TEST_F(InsertTests, InsertShiftsTailOnce) {
+  {
+    ekuvector<IChar> uut(5, IChar{'a'});
+    uut.reserve(10);
+    IChar var;
+    IChar::reset();
+    uut.insert(uut.begin(), var);
+    EXPECT_EQ(1, IChar::copy_ops_);
+    EXPECT_EQ(5, IChar::move_ops_);
+  }
+  {
+    ekuvector<IChar> uut(5, IChar{'a'});
+    uut.reserve(10);
+    IChar::reset();
+    uut.emplace(uut.begin() + 2, 'b');
+    EXPECT_EQ(1, IChar::value_constructor_);
+    EXPECT_EQ(0, IChar::copy_ops_);
+    EXPECT_EQ(4, IChar::move_ops_);
+  }
+}
+
+TEST_F(InsertTests, InsertElementOfTheSameContainer) {
+  {
+    ekuvector<std::string> uut({"97", "98", "99"});
+    uut.reserve(10);
+    uut.insert(uut.begin(), uut[1]);
+    EXPECT_EQ(ekuvector<std::string>({"98", "97", "98", "99"}), uut);
+    uut.emplace(uut.begin() + 1, uut.back());
+    EXPECT_EQ(ekuvector<std::string>({"98", "99", "97", "98", "99"}), uut);
+  }
+  {
+    ekuvector<int32_t> uut({97, 98, 99});
+    uut.shrink_to_fit();
+    uut.insert(uut.begin(), uut.back());
+    uut.insert(uut.begin() + 1, uut.back());
+    EXPECT_EQ(ekuvector<int32_t>({99, 99, 97, 98, 99}), uut);
+  }
+}
+
 class EraseTests : public EkuVectorTests {};
 
 TEST_F(EraseTests, EraseAtPos) {
@@ -1086,6 +1486,70 @@ TEST_F(EraseTests, EraseWithIterators) {
   };
 }
 
+TEST_F(EraseTests, EraseMovesTailOnce) {
+  ekuvector<IChar> uut(5, IChar{'a'});
+  IChar::reset();
+  uut.erase(uut.begin());
+  EXPECT_EQ(4, uut.size());
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(4, IChar::move_ops_);
+
+  IChar::reset();
+  uut.erase(uut.begin(), uut.begin() + 2);
+  EXPECT_EQ(2, uut.size());
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(2, IChar::move_ops_);
+}
+
+TEST_F(EraseTests, EraseUnordered) {
+  ekuvector<std::string> uut{"a", "b", "c", "d"};
+  auto it = uut.erase_unordered(uut.begin() + 1);
+  EXPECT_EQ(ekuvector<std::string>({"a", "d", "c"}), uut);
+  EXPECT_EQ("d", *it);
+
+  it = uut.erase_unordered(uut.end() - 1);
+  EXPECT_EQ(ekuvector<std::string>({"a", "d"}), uut);
+  EXPECT_TRUE(uut.end() == it);
+
+  ekuvector<IChar> chars(5, IChar{'a'});
+  IChar::reset();
+  chars.erase_unordered(chars.begin());
+  EXPECT_EQ(4, chars.size());
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(1, IChar::move_ops_);
+}
+
+TEST_F(EraseTests, EraseIfCompactsInOnePass) {
+  ekuvector<int32_t> uut{1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(3, uut.erase_if([](int32_t value) { return value % 2 == 0; }));
+  EXPECT_EQ(ekuvector<int32_t>({1, 3, 5, 7}), uut);
+  EXPECT_EQ(0, erase_if(uut, [](int32_t value) { return value > 10; }));
+  EXPECT_EQ(1, erase(uut, 1));
+  EXPECT_EQ(ekuvector<int32_t>({3, 5, 7}), uut);
+
+  ekuvector<std::unique_ptr<int32_t>> owners;
+  for (int32_t i = 0; i < 6; ++i) {
+    owners.push_back(std::make_unique<int32_t>(i));
+  }
+  EXPECT_EQ(6, erase_if(owners, [](const std::unique_ptr<int32_t> &) {
+              return true;
+            }));
+  EXPECT_TRUE(owners.empty());
+
+  // only the survivors after the first erased element get moved
+  ekuvector<IChar> chars{'a', 'b', 'c', 'd', 'e'};
+  IChar::reset();
+  int32_t index = 0;
+  EXPECT_EQ(2, chars.erase_if([&index](const IChar &) {
+    const auto erase = (index == 1) || (index == 3);
+    ++index;
+    return erase;
+  }));
+  EXPECT_EQ(3, chars.size());
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(2, IChar::move_ops_);
+}
+
 class PushPopTests : public EkuVectorTests {};
 
 TEST_F(PushPopTests, CopyPushBack) {
@@ -1174,6 +1638,66 @@ TEST_F(PushPopTests, PopBack) {
   };
 }
 
+TEST_F(PushPopTests, PushBackElementOfTheSameContainer) {
+  ekuvector<std::string> uut{"first value, long enough to live on the heap"};
+  for (int32_t i = 0; i < 10; ++i) {
+    uut.push_back(uut.front());
+    uut.emplace_back(uut.back());
+  }
+  ASSERT_EQ(21, uut.size());
+  for (const auto &item : uut) {
+    EXPECT_EQ(uut.front(), item);
+  }
+}
+
+TEST_F(PushPopTests, AppendRanges) {
+  ekuvector<std::string> uut{"a"};
+  const std::deque<std::string> source{"b", "c", "d"};
+  uut.append(source.begin(), source.end());
+  EXPECT_EQ(ekuvector<std::string>({"a", "b", "c", "d"}), uut);
+
+  // the range may come from the container itself
+  uut.append(uut.begin(), uut.begin() + 2);
+  EXPECT_EQ(ekuvector<std::string>({"a", "b", "c", "d", "a", "b"}), uut);
+
+  std::istringstream stream{"1 2 3"};
+  ekuvector<int32_t> numbers{0};
+  numbers.append(std::istream_iterator<int32_t>{stream},
+                 std::istream_iterator<int32_t>{});
+  EXPECT_EQ(ekuvector<int32_t>({0, 1, 2, 3}), numbers);
+}
+
+TEST_F(PushPopTests, AppendFromGenerator) {
+  ekuvector<int32_t> uut{-1};
+  int32_t next = 0;
+  uut.append(4, [&next]() { return next++; });
+  EXPECT_EQ(ekuvector<int32_t>({-1, 0, 1, 2, 3}), uut);
+
+  // a failing batch leaves the container as it was
+  const auto capacity = uut.capacity();
+  EXPECT_THROW(uut.append(10,
+                          [&next]() {
+                            if (next == 6) {
+                              throw std::runtime_error("generator failed");
+                            }
+                            return next++;
+                          }),
+               std::runtime_error);
+  EXPECT_EQ(ekuvector<int32_t>({-1, 0, 1, 2, 3}), uut);
+  EXPECT_LE(capacity, uut.capacity());
+}
+
+TEST_F(PushPopTests, UncheckedEmplaceBack) {
+  ekuvector<std::string> uut;
+  uut.reserve(3);
+  const auto data = uut.data();
+  uut.unchecked_emplace_back("a");
+  uut.unchecked_emplace_back(2, 'b');
+  uut.unchecked_emplace_back();
+  EXPECT_EQ(data, uut.data());
+  EXPECT_EQ(ekuvector<std::string>({"a", "bb", ""}), uut);
+}
+
 TEST_F(StorageManagementTests, ResizeWithDefaultConstructor) {
   {
     ekuvector<int32_t> uut;
@@ -1364,4 +1888,551 @@ TEST_F(OperatorTests, ComparisonOperators) {
   EXPECT_FALSE(v_e > v_r);
 }
 
+TEST_F(OperatorTests, ComparisonFastPaths) {
+  const ekuvector<uint8_t> bytes_a{1, 2, 200};
+  const ekuvector<uint8_t> bytes_b{1, 2, 100, 0};
+  EXPECT_TRUE(bytes_a == ekuvector<uint8_t>({1, 2, 200}));
+  EXPECT_TRUE(bytes_b < bytes_a);
+  EXPECT_TRUE(ekuvector<uint8_t>({1, 2}) < bytes_a);
+
+  const ekuvector<int8_t> signed_a{1, -1};
+  const ekuvector<int8_t> signed_b{1, 1};
+  EXPECT_TRUE(signed_a < signed_b);
+
+  // byte order must not leak into the ordering of wider integers
+  const ekuvector<uint32_t> words_a{1, 256};
+  const ekuvector<uint32_t> words_b{1, 1, 7};
+  EXPECT_TRUE(words_b < words_a);
+  EXPECT_FALSE(words_a < words_b);
+  EXPECT_TRUE(words_a == ekuvector<uint32_t>({1, 256}));
+
+  // floating point values keep their own notion of equality
+  const ekuvector<double> zeros{0.0, 1.0};
+  const ekuvector<double> negative_zeros{-0.0, 1.0};
+  EXPECT_TRUE(zeros == negative_zeros);
+  EXPECT_FALSE(zeros < negative_zeros);
+
+  const ekuvector<std::string> strings_a{"a", "b"};
+  const ekuvector<std::string> strings_b{"a", "c"};
+  EXPECT_TRUE(strings_a < strings_b);
+  EXPECT_TRUE(strings_a != strings_b);
+
+  // enums may bring their own operator==
+  const ekuvector<Flagged> flags_a{static_cast<Flagged>(1), Flagged::flag};
+  const ekuvector<Flagged> flags_b{static_cast<Flagged>(0x81),
+                                   static_cast<Flagged>(0)};
+  EXPECT_TRUE(flags_a == flags_b);
+  EXPECT_FALSE(flags_a != flags_b);
+}
+
+class GrowthPolicyTests : public EkuVectorTests {};
+
+TEST_F(GrowthPolicyTests, GeometricGrowthPolicy) {
+  EXPECT_EQ(1, geometric_growth<>::next_capacity(0, 1, sizeof(int32_t)));
+  EXPECT_EQ(20, geometric_growth<>::next_capacity(10, 11, sizeof(int32_t)));
+  EXPECT_EQ(30, geometric_growth<>::next_capacity(10, 30, sizeof(int32_t)));
+  EXPECT_EQ(15, (geometric_growth<3, 2>::next_capacity(10, 11, 1)));
+  EXPECT_EQ(11, geometric_growth<>::fit_capacity(11, sizeof(int32_t)));
+}
+
+TEST_F(GrowthPolicyTests, AdditiveGrowthPolicy) {
+  EXPECT_EQ(1024, additive_growth<>::next_capacity(0, 1, sizeof(int32_t)));
+  EXPECT_EQ(2048, additive_growth<>::next_capacity(1024, 1025, 1));
+  EXPECT_EQ(16, additive_growth<8>::next_capacity(8, 9, sizeof(int32_t)));
+  EXPECT_EQ(16, additive_growth<8>::fit_capacity(9, sizeof(int32_t)));
+}
+
+TEST_F(GrowthPolicyTests, PageAlignedGrowthPolicy) {
+  EXPECT_EQ(1024, page_aligned_growth<>::next_capacity(0, 1, sizeof(int32_t)));
+  EXPECT_EQ(2048,
+            page_aligned_growth<>::next_capacity(1024, 1025, sizeof(int32_t)));
+  EXPECT_EQ(4096 / 24, page_aligned_growth<>::next_capacity(0, 1, 24));
+  EXPECT_EQ(2048, page_aligned_growth<>::fit_capacity(1025, sizeof(int32_t)));
+}
+
+TEST_F(GrowthPolicyTests, PushBackGrowsGeometrically) {
+  ekuvector<int32_t> uut;
+  int32_t reallocations = 0;
+  for (int32_t i = 0; i < 100000; ++i) {
+    const auto previous_capacity = uut.capacity();
+    uut.push_back(i);
+    if (uut.capacity() != previous_capacity) {
+      ++reallocations;
+    }
+  }
+  ASSERT_EQ(100000, uut.size());
+  EXPECT_EQ(99999, uut.back());
+  // one reallocation per power of two
+  EXPECT_EQ(18, reallocations);
+}
+
+TEST_F(GrowthPolicyTests, PushBackWithAlternativePolicies) {
+  {
+    ekuvector<int32_t, std::allocator<int32_t>, additive_growth<>> uut;
+    uut.push_back(97);
+    EXPECT_EQ(1024, uut.capacity());
+    uut.resize(1025);
+    EXPECT_EQ(2048, uut.capacity());
+  }
+  {
+    ekuvector<std::string, std::allocator<std::string>, page_aligned_growth<>>
+        uut;
+    uut.push_back("97");
+    EXPECT_EQ(0, (uut.capacity() * sizeof(std::string)) % 4096);
+    EXPECT_EQ("97", uut.front());
+  }
+}
+
+TEST_F(GrowthPolicyTests, ReserveExactSkipsRounding) {
+  ekuvector<int32_t, std::allocator<int32_t>, additive_growth<8>> rounded;
+  rounded.reserve(9);
+  EXPECT_EQ(16, rounded.capacity());
+
+  ekuvector<int32_t, std::allocator<int32_t>, additive_growth<8>> exact{1, 2};
+  exact.reserve_exact(9);
+  EXPECT_EQ(9, exact.capacity());
+  exact.reserve_exact(3);
+  EXPECT_EQ(9, exact.capacity());
+  EXPECT_EQ(2, exact.back());
+}
+
+TEST_F(GrowthPolicyTests, TryReserveReportsFailure) {
+  ekuvector<FragileCopy> uut;
+  uut.reserve(2);
+  uut.emplace_back(0);
+  uut.emplace_back(1);
+  const auto data = uut.data();
+
+  EXPECT_FALSE(uut.try_reserve(uut.max_size() + 1));
+  FragileCopy::copies_left_ = 1;
+  EXPECT_FALSE(uut.try_reserve(10));
+  EXPECT_EQ(data, uut.data());
+  EXPECT_EQ(2, uut.capacity());
+  EXPECT_EQ(1, uut[1].value());
+
+  FragileCopy::copies_left_ = 2;
+  EXPECT_TRUE(uut.try_reserve(10));
+  EXPECT_TRUE(uut.try_reserve(5));
+  EXPECT_EQ(10, uut.capacity());
+  EXPECT_EQ(1, uut[1].value());
+}
+
+TEST_F(GrowthPolicyTests, NextCapacityPredictsGrowth) {
+  ekuvector<int32_t> uut;
+  EXPECT_EQ(1, uut.next_capacity(1));
+  uut.reserve(10);
+  EXPECT_EQ(10, uut.next_capacity(5));
+  EXPECT_EQ(20, uut.next_capacity(11));
+  EXPECT_EQ(30, uut.next_capacity(30));
+  EXPECT_EQ(10, uut.capacity());
+
+  ekuvector<std::string, std::allocator<std::string>, page_aligned_growth<>>
+      paged;
+  for (int32_t i = 0; i < 1000; ++i) {
+    const auto predicted = paged.next_capacity(paged.size() + 1);
+    paged.push_back("s");
+    ASSERT_EQ(predicted, paged.capacity());
+  }
+
+  // policies that round twice must still be predicted exactly
+  ekuvector<char, std::allocator<char>,
+            page_aligned_growth<4096, additive_growth<1000>>>
+      composed;
+  EXPECT_EQ(4096, composed.next_capacity(1));
+  for (int32_t i = 0; i < 20000; ++i) {
+    const auto old_capacity = composed.capacity();
+    const auto predicted = composed.next_capacity(composed.size() + 1);
+    composed.push_back('c');
+    if (composed.capacity() != old_capacity) {
+      ASSERT_EQ(predicted, composed.capacity());
+      ASSERT_EQ(composed.next_capacity(composed.size() + 1),
+                composed.capacity());
+    }
+  }
+  EXPECT_EQ(20480, composed.capacity());
+  composed.insert(composed.cbegin(), 5000, 'i');
+  EXPECT_EQ(28672, composed.capacity());
+}
+
+class RelocationTests : public EkuVectorTests {};
+
+TEST_F(RelocationTests, MovesAndSwapsDontThrow) {
+  using Vector = ekuvector<std::string>;
+  static_assert(std::is_nothrow_move_constructible<Vector>::value, "");
+  static_assert(std::is_nothrow_move_assignable<Vector>::value, "");
+  static_assert(std::is_nothrow_default_constructible<Vector>::value, "");
+  static_assert(noexcept(std::declval<Vector &>().swap(
+                    std::declval<Vector &>())),
+                "");
+
+  // a stateful allocator that doesn't propagate may need to allocate
+  using TaggedVector = ekuvector<IChar, TaggedAllocator<IChar>>;
+  static_assert(std::is_nothrow_move_constructible<TaggedVector>::value, "");
+  static_assert(!std::is_nothrow_move_assignable<TaggedVector>::value, "");
+}
+
+TEST_F(RelocationTests, NestedContainersRelocateByMoving) {
+  std::vector<ekuvector<std::string>> outer;
+  ekuvector<ekuvector<std::string>> eku_outer;
+  outer.emplace_back(3, "inner");
+  eku_outer.emplace_back(3, "inner");
+  const auto inner_data = outer.front().data();
+  const auto eku_inner_data = eku_outer.front().data();
+  for (int32_t i = 0; i < 100; ++i) {
+    outer.emplace_back(1, "more");
+    eku_outer.emplace_back(1, "more");
+  }
+  EXPECT_EQ(inner_data, outer.front().data());
+  EXPECT_EQ(eku_inner_data, eku_outer.front().data());
+}
+
+TEST_F(RelocationTests, StrongGuaranteeOnReallocation) {
+  ekuvector<FragileCopy> uut;
+  uut.reserve(4);
+  for (int32_t i = 0; i < 4; ++i) {
+    uut.emplace_back(i);
+  }
+  const auto data = uut.data();
+
+  // moves may throw, so the elements get copied to the new block instead
+  FragileCopy::moves_ = 0;
+  FragileCopy::copies_left_ = 2;
+  EXPECT_THROW(uut.emplace_back(4), std::runtime_error);
+  EXPECT_THROW(uut.reserve(10), std::runtime_error);
+  EXPECT_THROW(uut.insert(uut.begin(), {FragileCopy{-1}}), std::runtime_error);
+  EXPECT_EQ(0, FragileCopy::moves_);
+  ASSERT_EQ(4, uut.size());
+  EXPECT_EQ(data, uut.data());
+  for (int32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, uut[i].value());
+  }
+
+  FragileCopy::copies_left_ = 100;
+  uut.emplace_back(4);
+  EXPECT_EQ(5, uut.size());
+  EXPECT_EQ(4, uut.back().value());
+  EXPECT_EQ(0, FragileCopy::moves_);
+}
+
+TEST_F(RelocationTests, TriviallyCopyableElements) {
+  ekuvector<PackedRecord> uut;
+  for (int32_t i = 0; i < 1000; ++i) {
+    uut.push_back(PackedRecord{i, i * 0.5f, 'a'});
+  }
+  uut.insert(uut.begin(), 2, PackedRecord{-1, 0.0f, 'b'});
+  uut.erase(uut.begin() + 10, uut.begin() + 20);
+  uut.erase(uut.begin() + 500);
+
+  ASSERT_EQ(991, uut.size());
+  EXPECT_EQ((PackedRecord{-1, 0.0f, 'b'}), uut[0]);
+  EXPECT_EQ((PackedRecord{-1, 0.0f, 'b'}), uut[1]);
+  EXPECT_EQ((PackedRecord{7, 3.5f, 'a'}), uut[9]);
+  EXPECT_EQ((PackedRecord{18, 9.0f, 'a'}), uut[10]);
+  EXPECT_EQ((PackedRecord{507, 253.5f, 'a'}), uut[499]);
+  EXPECT_EQ((PackedRecord{509, 254.5f, 'a'}), uut[500]);
+  EXPECT_EQ((PackedRecord{999, 499.5f, 'a'}), uut.back());
+}
+
+TEST_F(RelocationTests, OptedInTriviallyRelocatableElements) {
+  ekuvector<std::unique_ptr<int32_t>> uut;
+  for (int32_t i = 0; i < 1000; ++i) {
+    uut.push_back(std::make_unique<int32_t>(i));
+  }
+  // this type can't be copied, so insert through a moving iterator
+  std::vector<std::unique_ptr<int32_t>> new_items;
+  new_items.push_back(std::make_unique<int32_t>(-1));
+  new_items.push_back(std::make_unique<int32_t>(-2));
+  uut.insert(uut.begin() + 1, std::make_move_iterator(new_items.begin()),
+             std::make_move_iterator(new_items.end()));
+  uut.erase(uut.begin() + 100, uut.begin() + 200);
+  uut.erase(uut.begin());
+
+  ASSERT_EQ(901, uut.size());
+  EXPECT_EQ(-1, *uut[0]);
+  EXPECT_EQ(-2, *uut[1]);
+  EXPECT_EQ(1, *uut[2]);
+  EXPECT_EQ(97, *uut[98]);
+  EXPECT_EQ(198, *uut[99]);
+  EXPECT_EQ(999, *uut.back());
+}
+
+TEST_F(RelocationTests, NonTriviallyRelocatableElements) {
+  ekuvector<IChar> uut(10, IChar{'a'});
+  IChar::reset();
+  uut.reserve(uut.capacity() + 1);
+  // every element is moved to the new block, and none gets copied
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(10, IChar::move_ops_);
+}
+
+class RangeTests : public EkuVectorTests {};
+
+TEST_F(RangeTests, ForwardRangesAllocateOnce) {
+  const std::deque<std::string> source{"a", "b", "c", "d", "e"};
+
+  ekuvector<std::string> constructed(source.begin(), source.end());
+  ASSERT_EQ(5, constructed.size());
+  EXPECT_EQ(5, constructed.capacity());
+  EXPECT_EQ("e", constructed[4]);
+
+  ekuvector<std::string> assigned;
+  assigned.assign(source.begin(), source.end());
+  ASSERT_EQ(5, assigned.size());
+  EXPECT_EQ(5, assigned.capacity());
+  EXPECT_EQ("a", assigned[0]);
+
+  ekuvector<IChar> uut({'x', 'y'});
+  const ekuvector<IChar> items({'a', 'b', 'c'});
+  IChar::reset();
+  uut.insert(uut.begin() + 1, items.begin(), items.end());
+  ASSERT_EQ(5, uut.size());
+  // one copy per new element, and one move per relocated element
+  EXPECT_EQ(3, IChar::copy_ops_);
+  EXPECT_EQ(2, IChar::move_ops_);
+}
+
+TEST_F(RangeTests, InputRanges) {
+  std::istringstream construct_stream("1 2 3");
+  ekuvector<int32_t> constructed(
+      std::istream_iterator<int32_t>{construct_stream},
+      std::istream_iterator<int32_t>{});
+  ASSERT_EQ(3, constructed.size());
+  EXPECT_EQ(3, constructed[2]);
+
+  std::istringstream assign_stream("4 5");
+  constructed.assign(std::istream_iterator<int32_t>{assign_stream},
+                     std::istream_iterator<int32_t>{});
+  ASSERT_EQ(2, constructed.size());
+  EXPECT_EQ(4, constructed[0]);
+  EXPECT_EQ(5, constructed[1]);
+
+  std::istringstream insert_stream("7 8 9");
+  constructed.insert(constructed.begin() + 1,
+                     std::istream_iterator<int32_t>{insert_stream},
+                     std::istream_iterator<int32_t>{});
+  const ekuvector<int32_t> expected({4, 7, 8, 9, 5});
+  EXPECT_TRUE(expected == constructed);
+}
+
+class StatsTests : public EkuVectorTests {};
+
+TEST_F(StatsTests, DisabledStatsTakeNoRoom) {
+  EXPECT_EQ(sizeof(ekuvector<int32_t>),
+            (sizeof(ekuvector<int32_t, std::allocator<int32_t>,
+                              geometric_growth<>, no_stats>)));
+#if !defined(EKUVECTOR_CHECKED)
+  EXPECT_GE(4 * sizeof(void *), sizeof(ekuvector<int32_t>));
+#endif
+}
+
+#if !defined(EKUVECTOR_CHECKED)
+TEST_F(EkuVectorTests, IteratorsArePlainPointers) {
+  EXPECT_TRUE((std::is_same<int32_t *, ekuvector<int32_t>::iterator>::value));
+  EXPECT_TRUE((std::is_same<const int32_t *,
+                            ekuvector<int32_t>::const_iterator>::value));
+}
+#endif
+
+TEST_F(StatsTests, CountsStorageEvents) {
+  struct Tag {};
+  using CountedVector = ekuvector<int32_t, std::allocator<int32_t>,
+                                  geometric_growth<>, counting_stats<Tag>>;
+  counting_stats<Tag>::reset_totals();
+  {
+    CountedVector uut;
+    for (int32_t i = 0; i < 100; ++i) {
+      uut.push_back(i);
+    }
+    // capacity went 1, 2, 4, ... 128
+    const auto &counters = uut.stats().counters();
+    EXPECT_EQ(8, counters.allocations);
+    EXPECT_EQ(7, counters.deallocations);
+    EXPECT_EQ(255 * sizeof(int32_t), counters.bytes_requested);
+    EXPECT_EQ(127, counters.elements_relocated);
+    EXPECT_EQ(128, counters.peak_capacity);
+    EXPECT_EQ(28, counters.wasted_capacity);
+
+    CountedVector other(10, 0);
+    EXPECT_EQ(1, other.stats().counters().allocations);
+    EXPECT_EQ(0, other.stats().counters().wasted_capacity);
+
+    // the other container had no room to spare
+    const auto totals = counting_stats<Tag>::totals();
+    EXPECT_EQ(9, totals.allocations);
+    EXPECT_EQ(128, totals.peak_capacity);
+    EXPECT_EQ(28, totals.wasted_capacity);
+  }
+  const auto totals = counting_stats<Tag>::totals();
+  EXPECT_EQ(9, totals.deallocations);
+  EXPECT_EQ(0, totals.wasted_capacity);
+}
+
+class OwnershipTests : public EkuVectorTests {};
+
+TEST_F(OwnershipTests, ReleasedBlocksCanBeAdopted) {
+  ekuvector<std::string> source({"a", "b", "c"});
+  source.reserve(10);
+  const auto data = source.data();
+
+  auto block = source.release();
+  EXPECT_TRUE(source.empty());
+  EXPECT_EQ(0, source.capacity());
+  EXPECT_EQ(nullptr, source.data());
+  EXPECT_EQ(data, block.data);
+  EXPECT_EQ(3, block.size);
+  EXPECT_EQ(10, block.capacity);
+
+  ekuvector<std::string> uut({"x"});
+  uut.adopt(block.data, block.size, block.capacity);
+  EXPECT_EQ(data, uut.data());
+  EXPECT_EQ(10, uut.capacity());
+  ASSERT_EQ(3, uut.size());
+  EXPECT_EQ("c", uut.back());
+  uut.push_back("d");
+  EXPECT_EQ(data, uut.data());
+}
+
+TEST_F(OwnershipTests, AdoptingExternalAllocations) {
+  std::allocator<int32_t> alloc;
+  auto buffer = alloc.allocate(64);
+  for (int32_t i = 0; i < 16; ++i) {
+    buffer[i] = i;
+  }
+  ekuvector<int32_t> uut;
+  uut.adopt(buffer, 16, 64);
+  EXPECT_EQ(15, uut.back());
+  uut.resize(64, 1);
+  EXPECT_EQ(buffer, uut.data());
+
+  auto block = uut.release();
+  block.allocator.deallocate(block.data, block.capacity);
+}
+
+/* pins the cost of the operations, counted in allocations and element
+   copies and moves, so that it can't silently regress */
+class ComplexityTests : public EkuVectorTests {
+protected:
+  using Counter = CountingAllocator<IChar>;
+  using Vector = ekuvector<IChar, Counter>;
+
+  void SetUp() override {
+    IChar::reset();
+    Counter::reset();
+  }
+
+  static Vector make_vector(int32_t count) {
+    Vector vector;
+    vector.reserve(count);
+    for (int32_t i = 0; i < count; ++i) {
+      vector.emplace_back(static_cast<char>(i));
+    }
+    IChar::reset();
+    Counter::reset();
+    return vector;
+  }
+};
+
+TEST_F(ComplexityTests, PushBacksAllocateLogarithmically) {
+  const int32_t count = 1 << 16;
+  Vector uut;
+  for (int32_t i = 0; i < count; ++i) {
+    uut.push_back(IChar('x'));
+  }
+  // one block per power of two, each one replacing the previous one
+  EXPECT_EQ(17, Counter::allocations_);
+  EXPECT_EQ(16, Counter::deallocations_);
+  // the moves into the vector, plus the relocations of amortized growth
+  EXPECT_EQ(count, IChar::value_constructor_);
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(2 * count - 1, IChar::move_ops_);
+}
+
+TEST_F(ComplexityTests, ReservedPushBacksDontAllocate) {
+  Vector uut;
+  uut.reserve(1000);
+  for (int32_t i = 0; i < 1000; ++i) {
+    uut.emplace_back('x');
+  }
+  EXPECT_EQ(1, Counter::allocations_);
+  EXPECT_EQ(0, IChar::move_ops_);
+  EXPECT_EQ(0, IChar::copy_ops_);
+}
+
+TEST_F(ComplexityTests, MovesTouchNoElements) {
+  auto source = make_vector(100);
+  Vector uut(std::move(source));
+  Vector other;
+  other = std::move(uut);
+  other.swap(uut);
+  EXPECT_EQ(100, uut.size());
+  EXPECT_EQ(0, IChar::move_ops_);
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(0, Counter::allocations_);
+  EXPECT_EQ(0, Counter::deallocations_);
+}
+
+TEST_F(ComplexityTests, CopiesAllocateOnce) {
+  const auto source = make_vector(100);
+  Vector uut(source);
+  EXPECT_EQ(1, Counter::allocations_);
+  EXPECT_EQ(100, IChar::copy_ops_);
+  EXPECT_EQ(0, IChar::move_ops_);
+
+  // copy assignment reuses the storage if it's large enough
+  IChar::reset();
+  Counter::reset();
+  uut = source;
+  EXPECT_EQ(0, Counter::allocations_);
+  EXPECT_EQ(100, IChar::copy_ops_);
+}
+
+TEST_F(ComplexityTests, FrontInsertionMovesEachElementOnce) {
+  const IChar value('v');
+  {
+    // with room to spare, the elements are shifted in place
+    auto uut = make_vector(100);
+    uut.reserve(200);
+    IChar::reset();
+    Counter::reset();
+    uut.insert(uut.begin(), value);
+    EXPECT_EQ(100, IChar::move_ops_);
+    EXPECT_EQ(1, IChar::copy_ops_);
+    EXPECT_EQ(0, Counter::allocations_);
+  }
+  {
+    // when full, the elements are relocated straight into their new places
+    auto uut = make_vector(100);
+    uut.insert(uut.begin(), value);
+    EXPECT_EQ(100, IChar::move_ops_);
+    EXPECT_EQ(1, IChar::copy_ops_);
+    EXPECT_EQ(1, Counter::allocations_);
+  }
+  {
+    auto uut = make_vector(100);
+    uut.reserve(200);
+    const IChar values[] = {'a', 'b', 'c'};
+    IChar::reset();
+    uut.insert(uut.begin(), std::begin(values), std::end(values));
+    EXPECT_EQ(100, IChar::move_ops_);
+    EXPECT_EQ(3, IChar::copy_ops_);
+  }
+}
+
+TEST_F(ComplexityTests, ErasureMovesOnlyTheTail) {
+  auto uut = make_vector(100);
+  uut.erase(uut.begin());
+  EXPECT_EQ(99, IChar::move_ops_);
+  IChar::reset();
+  uut.erase(uut.begin() + 89, uut.begin() + 94);
+  EXPECT_EQ(5, IChar::move_ops_);
+  IChar::reset();
+  uut.erase_unordered(uut.begin());
+  EXPECT_EQ(1, IChar::move_ops_);
+  uut.pop_back();
+  uut.clear();
+  EXPECT_EQ(0, IChar::copy_ops_);
+  EXPECT_EQ(0, Counter::allocations_);
+  EXPECT_EQ(0, Counter::deallocations_);
+}
+
 }; // namespace ekustd
@@ -0,0 +1,92 @@
+/**
+ * ekuvector, std::vector clone.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekuvector.hpp>
+
+#if !defined(EKUVECTOR_CHECKED)
+#error "these tests must be built with EKUVECTOR_CHECKED defined"
+#endif
+
+namespace ekustd {
+
+class CheckedIteratorTests : public testing::Test {};
+
+TEST_F(CheckedIteratorTests, ValidUseIsUnaffected) {
+  static_assert(!std::is_pointer<ekuvector<int32_t>::iterator>::value,
+                "checked iterators are classes");
+  ekuvector<int32_t> uut{5, 3, 1, 4, 2};
+  std::sort(uut.begin(), uut.end());
+  EXPECT_EQ((ekuvector<int32_t>{1, 2, 3, 4, 5}), uut);
+  std::sort(uut.rbegin(), uut.rend());
+  EXPECT_EQ(5, uut.front());
+
+  ekuvector<int32_t>::const_iterator first = uut.begin();
+  EXPECT_TRUE(first == uut.cbegin());
+  EXPECT_EQ(5, uut.cend() - uut.begin());
+  EXPECT_TRUE(uut.begin() < uut.cend());
+  EXPECT_EQ(3, first[2]);
+  EXPECT_EQ(uut.end(), std::find(uut.begin(), uut.end(), 42));
+
+  // growing within the capacity keeps every iterator valid
+  uut.reserve(10);
+  auto it = uut.begin() + 1;
+  uut.push_back(0);
+  EXPECT_EQ(4, *it);
+  it = uut.insert(it, 7);
+  EXPECT_EQ(7, *it);
+  it = uut.erase(it);
+  EXPECT_EQ(4, *it);
+}
+
+TEST_F(CheckedIteratorTests, ReallocationInvalidatesIterators) {
+  ekuvector<std::string> uut{"a", "b"};
+  auto it = uut.begin();
+  auto end = uut.cend();
+  uut.reserve(100);
+  EXPECT_DEATH(*it, "used after a reallocation");
+  EXPECT_DEATH(++it, "used after a reallocation");
+  EXPECT_DEATH(uut.insert(end, "c"), "used after a reallocation");
+
+  it = uut.begin();
+  uut.shrink_to_fit();
+  EXPECT_DEATH(it->size(), "used after a reallocation");
+
+  ekuvector<std::string> other{"x"};
+  it = uut.begin();
+  uut.swap(other);
+  EXPECT_DEATH(*it, "used after a reallocation");
+}
+
+TEST_F(CheckedIteratorTests, OutOfRangeAccess) {
+  ekuvector<int32_t> uut{1, 2, 3};
+  EXPECT_DEATH(uut[3], "index out of range");
+  EXPECT_DEATH(*uut.end(), "not dereferenceable");
+  EXPECT_DEATH(uut.begin() + 4, "moved out of range");
+  EXPECT_DEATH(uut.erase(uut.end()), "past the end");
+  EXPECT_DEATH(uut.erase(uut.end(), uut.begin()), "reversed range");
+
+  ekuvector<int32_t> other{4};
+  EXPECT_DEATH(uut.insert(other.begin(), 5), "another container");
+  EXPECT_DEATH(static_cast<void>(uut.begin() == other.begin()),
+               "different containers");
+
+  const ekuvector<int32_t> empty;
+  EXPECT_DEATH(empty.front(), "empty container");
+  EXPECT_DEATH(empty.back(), "empty container");
+  EXPECT_DEATH(*ekuvector<int32_t>::iterator{}, "singular");
+}
+
+}; // namespace ekustd
@@ -0,0 +1,158 @@
+/**
+ * ekuchunked_vector, vector made of fixed-size chunks with stable addresses.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekuchunked_vector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* counts how many times any instance was moved or copied */
+struct Counted {
+  static int32_t relocations;
+
+  explicit Counted(int32_t v) : value{v} {}
+  Counted(const Counted &other) : value{other.value} { ++relocations; }
+  Counted(Counted &&other) noexcept : value{other.value} { ++relocations; }
+  Counted &operator=(const Counted &) = default;
+  Counted &operator=(Counted &&) = default;
+
+  int32_t value;
+};
+
+int32_t Counted::relocations = 0;
+
+} // namespace
+
+class EkuChunkedVectorTests : public testing::Test {};
+
+TEST_F(EkuChunkedVectorTests, GrowthKeepsAddressesStable) {
+  ekuchunked_vector<Counted, 16> uut;
+  uut.emplace_back(0);
+  const auto first = &uut.front();
+  std::vector<const Counted *> addresses;
+  Counted::relocations = 0;
+  for (int32_t i = 1; i < 1000; ++i) {
+    addresses.push_back(&uut.emplace_back(i));
+  }
+  EXPECT_EQ(0, Counted::relocations);
+  EXPECT_EQ(first, &uut.front());
+  for (int32_t i = 1; i < 1000; ++i) {
+    ASSERT_EQ(addresses[i - 1], &uut[i]);
+    ASSERT_EQ(i, uut[i].value);
+  }
+  EXPECT_EQ(1000, uut.size());
+  EXPECT_EQ(1008, uut.capacity());
+  EXPECT_EQ(16, (ekuchunked_vector<Counted, 16>::chunk_size));
+}
+
+TEST_F(EkuChunkedVectorTests, SegmentsAndIterators) {
+  ekuchunked_vector<int32_t, 8> uut(20);
+  std::iota(uut.begin(), uut.end(), 0);
+  std::vector<std::size_t> counts;
+  int32_t expected = 0;
+  uut.for_each_segment([&](int32_t *first, std::size_t count) {
+    counts.push_back(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      first[i] *= 2;
+    }
+  });
+  const auto &const_uut = uut;
+  const_uut.for_each_segment([&](const int32_t *first, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(2 * expected++, first[i]);
+    }
+  });
+  EXPECT_EQ((std::vector<std::size_t>{8, 8, 4}), counts);
+
+  EXPECT_EQ(20, uut.end() - uut.begin());
+  EXPECT_EQ(38, *uut.rbegin());
+  EXPECT_EQ(16, uut.cbegin()[8]);
+  ekuchunked_vector<int32_t, 8>::const_iterator found =
+      std::find(uut.begin(), uut.end(), 30);
+  EXPECT_EQ(15, found - uut.cbegin());
+  EXPECT_TRUE(std::is_sorted(uut.cbegin(), uut.cend()));
+  EXPECT_EQ(38, uut.back());
+  EXPECT_EQ(38, uut.at(19));
+  EXPECT_THROW(uut.at(20), std::out_of_range);
+}
+
+TEST_F(EkuChunkedVectorTests, InsertAndErase) {
+  ekuchunked_vector<std::string, 4> uut{"a", "b", "c", "d", "e"};
+  auto it = uut.insert(uut.cbegin() + 1, "x");
+  EXPECT_EQ("x", *it);
+  it = uut.insert(uut.cend(), 3, "y");
+  EXPECT_EQ(6, it - uut.begin());
+  const std::string more[] = {"p", "q"};
+  uut.insert(uut.cbegin(), std::begin(more), std::end(more));
+  uut.emplace(uut.cbegin() + 3, 2, 'z');
+  uut.insert(uut.cbegin(), uut.front());
+  EXPECT_EQ((ekuchunked_vector<std::string, 4>{"p", "p", "q", "a", "zz", "x",
+                                               "b", "c", "d", "e", "y", "y",
+                                               "y"}),
+            uut);
+
+  it = uut.erase(uut.cbegin() + 4);
+  EXPECT_EQ("x", *it);
+  it = uut.erase(uut.cbegin() + 9, uut.cend());
+  EXPECT_EQ(uut.end(), it);
+  uut.erase(uut.cbegin(), uut.cbegin() + 2);
+  EXPECT_EQ((ekuchunked_vector<std::string, 4>{"q", "a", "x", "b", "c", "d",
+                                               "e"}),
+            uut);
+  uut.pop_back();
+  EXPECT_EQ("d", uut.back());
+}
+
+TEST_F(EkuChunkedVectorTests, CapacityAndOwnership) {
+  ekuchunked_vector<std::string, 4> uut(10, "s");
+  EXPECT_EQ(12, uut.capacity());
+  uut.reserve(30);
+  EXPECT_EQ(32, uut.capacity());
+  uut.resize(3);
+  uut.shrink_to_fit();
+  EXPECT_EQ(4, uut.capacity());
+  uut.resize(6, "t");
+  EXPECT_EQ("t", uut[5]);
+  EXPECT_EQ("s", uut[2]);
+
+  ekuchunked_vector<std::string, 4> copy(uut);
+  const auto first = &uut.front();
+  ekuchunked_vector<std::string, 4> moved(std::move(uut));
+  EXPECT_TRUE(uut.empty());
+  EXPECT_EQ(first, &moved.front());
+  EXPECT_EQ(copy, moved);
+  copy.push_back("u");
+  EXPECT_LT(moved, copy);
+  EXPECT_NE(moved, copy);
+
+  uut = std::move(copy);
+  EXPECT_EQ(7, uut.size());
+  copy = uut;
+  EXPECT_EQ(uut, copy);
+  swap(copy, moved);
+  EXPECT_EQ(6, copy.size());
+  EXPECT_EQ(7, moved.size());
+  copy.assign({"v", "w"});
+  EXPECT_EQ(2, copy.size());
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(8, copy.capacity());
+}
+
+}; // namespace ekustd
@@ -0,0 +1,150 @@
+/**
+ * ekuconcurrent_vector, append-only vector for many concurrent producers.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekuconcurrent_vector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* throws from its constructor when given a negative value */
+class Picky {
+public:
+  explicit Picky(int32_t value) : value_{value} {
+    if (value < 0) {
+      throw std::invalid_argument("negative value");
+    }
+    ++live_;
+  }
+  Picky(const Picky &other) : value_{other.value_} { ++live_; }
+  ~Picky() { --live_; }
+
+  int32_t value() const noexcept { return value_; }
+
+  static int32_t live_;
+
+private:
+  int32_t value_;
+};
+
+int32_t Picky::live_ = 0;
+
+} // namespace
+
+class EkuConcurrentVectorTests : public testing::Test {};
+
+TEST_F(EkuConcurrentVectorTests, SegmentsDoubleInSize) {
+  using Vector = ekuconcurrent_vector<int32_t, std::allocator<int32_t>, 4>;
+  EXPECT_EQ(0, Vector::segment_start(0));
+  EXPECT_EQ(4, Vector::segment_size(0));
+  EXPECT_EQ(4, Vector::segment_start(1));
+  EXPECT_EQ(8, Vector::segment_size(1));
+  EXPECT_EQ(12, Vector::segment_start(2));
+
+  Vector uut;
+  EXPECT_TRUE(uut.empty());
+  EXPECT_EQ(0, uut.segment_count());
+  for (int32_t i = 0; i < 13; ++i) {
+    EXPECT_EQ(static_cast<std::size_t>(i), uut.push_back(i));
+  }
+  EXPECT_EQ(13, uut.size());
+  EXPECT_EQ(3, uut.segment_count());
+  EXPECT_EQ(28, uut.capacity());
+  EXPECT_EQ(12, uut[12]);
+  EXPECT_THROW(uut.at(13), std::out_of_range);
+
+  // the first two segments are full and contiguous
+  ASSERT_TRUE(uut.segment_complete(1));
+  const auto second = uut.segment_data(1);
+  ASSERT_NE(nullptr, second);
+  for (int32_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(4 + i, second[i]);
+  }
+  EXPECT_FALSE(uut.segment_complete(2));
+  EXPECT_EQ(nullptr, uut.segment_data(2));
+}
+
+TEST_F(EkuConcurrentVectorTests, ConcurrentProducers) {
+  constexpr int32_t producers = 8;
+  constexpr int32_t per_producer = 20000;
+  ekuconcurrent_vector<int64_t> uut;
+  std::vector<const int64_t *> addresses(producers);
+
+  std::vector<std::thread> threads;
+  for (int32_t producer = 0; producer < producers; ++producer) {
+    threads.emplace_back([&uut, &addresses, producer]() {
+      const auto first = uut.push_back(int64_t{producer} * per_producer);
+      addresses[producer] = &uut[first];
+      for (int32_t i = 1; i < per_producer; ++i) {
+        uut.emplace_back(int64_t{producer} * per_producer + i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(producers * per_producer, uut.size());
+  std::vector<bool> seen(uut.size(), false);
+  for (std::size_t pos = 0; pos < uut.size(); ++pos) {
+    ASSERT_FALSE(seen[uut[pos]]);
+    seen[uut[pos]] = true;
+  }
+  // growth never moved the elements pushed early on
+  for (int32_t producer = 0; producer < producers; ++producer) {
+    EXPECT_EQ(producer * per_producer, *addresses[producer]);
+  }
+  for (std::size_t segment = 0; segment + 1 < uut.segment_count();
+       ++segment) {
+    EXPECT_TRUE(uut.segment_complete(segment));
+  }
+}
+
+TEST_F(EkuConcurrentVectorTests, ReserveAndClear) {
+  ekuconcurrent_vector<std::string> uut;
+  uut.reserve(100);
+  EXPECT_LE(100, uut.capacity());
+  EXPECT_TRUE(uut.empty());
+  for (int32_t i = 0; i < 1000; ++i) {
+    uut.push_back(std::to_string(i));
+  }
+  EXPECT_EQ("999", uut[999]);
+  uut.clear();
+  EXPECT_TRUE(uut.empty());
+  EXPECT_EQ(0, uut.capacity());
+  uut.emplace_back(3, 'a');
+  EXPECT_EQ("aaa", uut[0]);
+  EXPECT_THROW(uut.reserve(uut.max_size() + 1), std::length_error);
+}
+
+TEST_F(EkuConcurrentVectorTests, FailedConstructionLeavesAHole) {
+  {
+    ekuconcurrent_vector<Picky, std::allocator<Picky>, 4> uut;
+    uut.emplace_back(1);
+    EXPECT_THROW(uut.emplace_back(-1), std::invalid_argument);
+    uut.emplace_back(3);
+    uut.emplace_back(4);
+    EXPECT_EQ(4, uut.size());
+    EXPECT_EQ(3, Picky::live_);
+    EXPECT_EQ(4, uut[3].value());
+    // the segment is done, but it's not contiguous
+    EXPECT_FALSE(uut.segment_complete(0));
+    EXPECT_EQ(nullptr, uut.segment_data(0));
+  }
+  EXPECT_EQ(0, Picky::live_);
+}
+
+}; // namespace ekustd
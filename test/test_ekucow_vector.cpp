@@ -0,0 +1,213 @@
+/**
+ * ekucow_vector, copy-on-write ekuvector for read-mostly data.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekucow_vector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* read-only view of a container, to reach its non-detaching members */
+template <class Type> const Type &as_const(Type &value) { return value; }
+
+/* counts how many times any instance was copied */
+struct Copied {
+  static int32_t copies_;
+
+  explicit Copied(int32_t value = 0) : value_{value} {}
+  Copied(const Copied &other) : value_{other.value_} { ++copies_; }
+  Copied(Copied &&other) noexcept = default;
+  Copied &operator=(const Copied &other) = default;
+  Copied &operator=(Copied &&other) = default;
+
+  int32_t value_;
+};
+
+int32_t Copied::copies_ = 0;
+
+} // namespace
+
+class EkuCowVectorTests : public testing::Test {};
+
+TEST_F(EkuCowVectorTests, CopiesShareTheBuffer) {
+  const ekucow_vector<std::string> uut{"a", "b", "c"};
+  EXPECT_EQ(1, uut.use_count());
+
+  const auto copy = uut;
+  EXPECT_EQ(uut.data(), copy.data());
+  EXPECT_EQ(2, uut.use_count());
+  EXPECT_TRUE(copy.is_shared());
+  EXPECT_TRUE(uut == copy);
+
+  ekucow_vector<std::string> assigned;
+  EXPECT_EQ(0, assigned.use_count());
+  EXPECT_EQ(nullptr, assigned.data());
+  assigned = copy;
+  EXPECT_EQ(3, uut.use_count());
+  EXPECT_EQ("c", assigned.back());
+}
+
+TEST_F(EkuCowVectorTests, ModificationsDetach) {
+  ekucow_vector<int32_t> uut{1, 2, 3};
+  auto copy = uut;
+  const auto shared_data = as_const(uut).data();
+
+  copy.push_back(4);
+  EXPECT_EQ(1, copy.use_count());
+  EXPECT_EQ(1, uut.use_count());
+  EXPECT_NE(shared_data, as_const(copy).data());
+  ASSERT_EQ(3, uut.size());
+  ASSERT_EQ(4, copy.size());
+  EXPECT_TRUE(uut < copy);
+
+  // the buffer is no longer shared, so further changes happen in place
+  const auto own_data = as_const(copy).data();
+  copy.pop_back();
+  EXPECT_EQ(own_data, as_const(copy).data());
+  EXPECT_TRUE(uut == copy);
+}
+
+TEST_F(EkuCowVectorTests, MutableAccessDetachesAndStopsSharing) {
+  ekucow_vector<int32_t> uut{1, 2, 3};
+  const auto copy = uut;
+
+  int32_t &element = uut[0];
+  EXPECT_FALSE(uut.is_shared());
+  element = 10;
+  EXPECT_EQ(1, copy[0]);
+
+  // element may still be written through, so copies can't share the buffer
+  const auto later = uut;
+  EXPECT_FALSE(uut.is_shared());
+  EXPECT_NE(uut.cbegin(), later.cbegin());
+  element = 20;
+  EXPECT_EQ(20, uut[0]);
+  EXPECT_EQ(10, later[0]);
+
+  // new contents invalidate element, so sharing resumes
+  uut.assign({4, 5});
+  const auto shared = uut;
+  EXPECT_EQ(2, uut.use_count());
+  EXPECT_EQ(uut.cbegin(), shared.cbegin());
+}
+
+TEST_F(EkuCowVectorTests, ModifiersThroughSharedIterators) {
+  ekucow_vector<std::string> uut{"a", "b", "c", "d"};
+  const auto copy = uut;
+
+  auto it = uut.insert(uut.cbegin() + 1, "x");
+  EXPECT_EQ("x", *it);
+  it = uut.erase(uut.cbegin() + 3, uut.cend());
+  EXPECT_EQ(uut.end(), it);
+  uut.emplace(uut.cbegin(), 2, 'z');
+  uut.insert(uut.cend(), copy.begin(), copy.end());
+
+  const std::vector<std::string> expected{"zz", "a", "x", "b",
+                                          "a",  "b", "c", "d"};
+  ASSERT_EQ(expected.size(), uut.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i], uut[i]);
+  }
+  ASSERT_EQ(4, copy.size());
+  EXPECT_EQ("d", copy.back());
+
+  // assigning a range out of the shared buffer
+  auto other = copy;
+  other.assign(copy.begin() + 2, copy.end());
+  ASSERT_EQ(2, other.size());
+  EXPECT_EQ("c", other.front());
+  EXPECT_EQ(4, copy.size());
+}
+
+TEST_F(EkuCowVectorTests, ClearReleasesSharedBuffers) {
+  ekucow_vector<int32_t> uut(100);
+  auto copy = uut;
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(0, copy.capacity());
+  EXPECT_EQ(1, uut.use_count());
+  EXPECT_EQ(100, uut.size());
+
+  copy.swap(uut);
+  EXPECT_TRUE(uut.empty());
+  EXPECT_EQ(100, copy.size());
+
+  auto moved = std::move(copy);
+  EXPECT_EQ(0, copy.use_count());
+  EXPECT_EQ(1, moved.use_count());
+  EXPECT_EQ(100, moved.size());
+}
+
+TEST_F(EkuCowVectorTests, OverwritingSharedBuffersCopiesOnlyWhatsKept) {
+  const ekucow_vector<Copied> source(1000, Copied(7));
+
+  auto assigned = source;
+  Copied::copies_ = 0;
+  assigned.assign(3, as_const(assigned)[999]);
+  // one more copy of value may be kept aside while the new buffer grows
+  EXPECT_GE(4, Copied::copies_);
+  EXPECT_EQ(7, as_const(assigned)[2].value_);
+  EXPECT_EQ(1000, source.size());
+
+  auto shrunk = source;
+  Copied::copies_ = 0;
+  shrunk.resize(2);
+  EXPECT_EQ(2, Copied::copies_);
+  EXPECT_EQ(2, shrunk.size());
+
+  auto filled = source;
+  Copied::copies_ = 0;
+  filled.resize(10, as_const(filled)[0]);
+  EXPECT_EQ(10, Copied::copies_);
+  filled = source;
+  Copied::copies_ = 0;
+  filled.resize(1500, Copied(8));
+  EXPECT_EQ(1500, Copied::copies_);
+  EXPECT_EQ(1500, filled.capacity());
+  EXPECT_EQ(8, as_const(filled).back().value_);
+  EXPECT_EQ(1, source.use_count());
+}
+
+TEST_F(EkuCowVectorTests, FanOutAcrossThreads) {
+  ekucow_vector<int64_t> source;
+  for (int64_t i = 0; i < 1000; ++i) {
+    source.push_back(i);
+  }
+
+  std::vector<int64_t> sums(4, 0);
+  std::vector<std::thread> workers;
+  for (std::size_t worker = 0; worker < sums.size(); ++worker) {
+    workers.emplace_back([copy = source, &sums, worker]() mutable {
+      for (const auto value : as_const(copy)) {
+        sums[worker] += value;
+      }
+      // writers get a private buffer, leaving the rest untouched
+      copy.push_back(-1);
+      sums[worker] += copy.back();
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (const auto sum : sums) {
+    EXPECT_EQ(999 * 1000 / 2 - 1, sum);
+  }
+  EXPECT_EQ(1, source.use_count());
+  EXPECT_EQ(1000, source.size());
+}
+
+}; // namespace ekustd
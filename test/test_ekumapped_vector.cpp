@@ -0,0 +1,106 @@
+/**
+ * ekumapped_vector, ekuvector stored in a memory mapped file.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekumapped_allocator.hpp>
+
+namespace ekustd {
+
+namespace {
+
+struct Sample {
+  int64_t timestamp;
+  double value;
+};
+
+} // namespace
+
+class EkuMappedVectorTests : public testing::Test {
+protected:
+  void SetUp() override {
+    path_ = testing::TempDir() + "ekumapped_" +
+            testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  std::string path_;
+};
+
+TEST_F(EkuMappedVectorTests, ContentsSurviveReopening) {
+  {
+    ekumapped_vector<Sample> uut(path_);
+    EXPECT_TRUE(uut.empty());
+    for (int64_t i = 0; i < 10000; ++i) {
+      uut.push_back(Sample{i, i * 0.5});
+    }
+    uut.sync();
+  }
+  {
+    ekumapped_vector<Sample> uut(path_);
+    ASSERT_EQ(10000, uut.size());
+    EXPECT_EQ(9999, uut.back().timestamp);
+    EXPECT_EQ(2.5, uut[5].value);
+    uut.erase(uut.begin(), uut.begin() + 5000);
+    uut.push_back(Sample{-1, -1.0});
+  }
+  ekumapped_vector<Sample> uut(path_);
+  ASSERT_EQ(5001, uut.size());
+  EXPECT_EQ(5000, uut.front().timestamp);
+  EXPECT_EQ(-1, uut.back().timestamp);
+}
+
+TEST_F(EkuMappedVectorTests, GrowsInPlace) {
+  ekumapped_vector<int32_t> uut(path_);
+  uut.push_back(7);
+  // every growth step resizes the one mapping of the file
+  for (int32_t i = 0; i < 100000; ++i) {
+    uut.push_back(i);
+  }
+  const int32_t head[] = {-2, -1};
+  uut.insert(uut.begin(), head, head + 2);
+  uut.emplace(uut.begin(), uut.back());
+  ASSERT_EQ(100004, uut.size());
+  EXPECT_EQ(99999, uut[0]);
+  EXPECT_EQ(-2, uut[1]);
+  EXPECT_EQ(-1, uut[2]);
+  EXPECT_EQ(7, uut[3]);
+  EXPECT_LE(uut.size(), uut.file().stored_capacity());
+
+  uut.resize(10);
+  uut.shrink_to_fit();
+  EXPECT_GE(4096 / sizeof(int32_t), uut.file().stored_capacity());
+  EXPECT_EQ(5, uut[9]);
+}
+
+TEST_F(EkuMappedVectorTests, RejectsForeignFiles) {
+  {
+    ekumapped_vector<int64_t> uut(path_);
+    uut.push_back(1);
+  }
+  EXPECT_THROW(ekumapped_vector<int32_t>{path_}, std::runtime_error);
+  EXPECT_THROW(ekumapped_vector<int32_t>{path_ + "/missing/file"},
+               std::system_error);
+
+  // a block is already mapped, copies need an allocator of their own
+  ekumapped_vector<int64_t> uut(path_);
+  EXPECT_THROW(ekumapped_vector<int64_t>::vector_type{uut},
+               std::bad_alloc);
+  const ekuvector<int64_t> copy(uut.begin(), uut.end());
+  EXPECT_EQ(1, copy[0]);
+}
+
+}; // namespace ekustd
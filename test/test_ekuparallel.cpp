@@ -0,0 +1,162 @@
+/**
+ * ekuparallel_policy and the parallel overloads of ekuvector.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekuparallel.hpp>
+#include <ekuvector/ekuvector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* keeps count of live instances, and throws from the copy constructor once
+   copies_left_ runs out */
+class Tracked {
+public:
+  explicit Tracked(int32_t value) : value_{value} { ++live_; }
+
+  Tracked(const Tracked &other) : value_{other.value_} {
+    if (copies_left_.fetch_sub(1) <= 0) {
+      throw std::runtime_error("copy failed");
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      threads_.insert(std::this_thread::get_id());
+    }
+    ++live_;
+  }
+
+  ~Tracked() { --live_; }
+
+  int32_t value() const noexcept { return value_; }
+
+  static std::atomic<int32_t> live_;
+  static std::atomic<int32_t> copies_left_;
+  static std::mutex mutex_;
+  static std::set<std::thread::id> threads_;
+
+private:
+  int32_t value_;
+};
+
+std::atomic<int32_t> Tracked::live_{0};
+std::atomic<int32_t> Tracked::copies_left_{0};
+std::mutex Tracked::mutex_;
+std::set<std::thread::id> Tracked::threads_;
+
+} // namespace
+
+class EkuParallelTests : public testing::Test {
+protected:
+  void SetUp() override {
+    Tracked::live_ = 0;
+    Tracked::copies_left_ = INT32_MAX;
+    Tracked::threads_.clear();
+  }
+
+  void TearDown() override { ASSERT_EQ(0, Tracked::live_); }
+};
+
+TEST_F(EkuParallelTests, ChunksCoverTheWholeRange) {
+  const ekuparallel_policy policy(7, 10);
+  auto quiet = [](std::size_t, std::size_t) noexcept {};
+  auto loud = [](std::size_t, std::size_t) {};
+  static_assert(noexcept(policy.for_each_chunk(1, quiet, quiet)),
+                "work that can't throw makes for_each_chunk() noexcept");
+  static_assert(!noexcept(policy.for_each_chunk(1, loud, quiet)), "");
+  EXPECT_EQ(7, policy.threads());
+  EXPECT_EQ(10, policy.grain());
+  EXPECT_LE(1, ekuparallel_policy().threads());
+
+  for (const std::size_t count : {0, 5, 19, 20, 71, 1000}) {
+    std::vector<std::atomic<int32_t>> hits(count);
+    std::atomic<int32_t> chunks{0};
+    policy.for_each_chunk(
+        count,
+        [&](std::size_t first, std::size_t last) {
+          ++chunks;
+          for (auto index = first; index < last; ++index) {
+            ++hits[index];
+          }
+        },
+        [](std::size_t, std::size_t) { FAIL(); });
+    for (const auto &hit : hits) {
+      ASSERT_EQ(1, hit);
+    }
+    const auto expected = std::max<std::size_t>(1, std::min<std::size_t>(
+                                                       7, count / 10));
+    EXPECT_EQ(expected, chunks);
+  }
+}
+
+TEST_F(EkuParallelTests, BulkOperationsMatchTheSerialOnes) {
+  const ekuparallel_policy policy(4, 16);
+  ekuvector<std::string> uut(policy, 1000, "value");
+  EXPECT_TRUE(ekuvector<std::string>(1000, "value") == uut);
+
+  for (std::size_t index = 0; index < uut.size(); ++index) {
+    uut[index] = std::to_string(index);
+  }
+  ekuvector<std::string> copy(policy, uut);
+  EXPECT_TRUE(copy == uut);
+
+  copy.assign(policy, 10, "short");
+  EXPECT_TRUE(ekuvector<std::string>(10, "short") == copy);
+  copy.assign(policy, 5000, "long");
+  EXPECT_TRUE(ekuvector<std::string>(5000, "long") == copy);
+  copy.clear(policy);
+  EXPECT_TRUE(copy.empty());
+
+  ekuvector<int64_t> numbers(policy, 100000, int64_t{42});
+  numbers.clear(policy);
+  EXPECT_TRUE(numbers.empty());
+}
+
+TEST_F(EkuParallelTests, ChunksRunOnSeveralThreads) {
+  const ekuparallel_policy policy(4, 8);
+  const Tracked prototype(7);
+  ekuvector<Tracked> uut(policy, 64, prototype);
+  EXPECT_EQ(65, Tracked::live_);
+  EXPECT_LT(1u, Tracked::threads_.size());
+  EXPECT_EQ(7, uut.back().value());
+
+  uut.clear(policy);
+  EXPECT_EQ(1, Tracked::live_);
+}
+
+TEST_F(EkuParallelTests, FailedChunksRollBack) {
+  const ekuparallel_policy policy(4, 8);
+  const Tracked prototype(1);
+  ekuvector<Tracked> source(64, prototype);
+
+  Tracked::copies_left_ = 40;
+  EXPECT_THROW(ekuvector<Tracked>(policy, source), std::runtime_error);
+  EXPECT_EQ(65, Tracked::live_);
+
+  Tracked::copies_left_ = INT32_MAX;
+  ekuvector<Tracked> uut(8, prototype);
+  Tracked::copies_left_ = 20;
+  EXPECT_THROW(uut.assign(policy, 64, prototype), std::runtime_error);
+  EXPECT_TRUE(uut.empty());
+  EXPECT_EQ(65, Tracked::live_);
+
+  Tracked::copies_left_ = INT32_MAX;
+  uut.assign(policy, 64, prototype);
+  EXPECT_EQ(129, Tracked::live_);
+}
+
+}; // namespace ekustd
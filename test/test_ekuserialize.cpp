@@ -0,0 +1,116 @@
+/**
+ * Binary serialization of ekuvectors of trivially copyable types.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekuserialize.hpp>
+
+namespace ekustd {
+
+namespace {
+
+struct Point {
+  float x;
+  float y;
+  int32_t id;
+};
+
+} // namespace
+
+class EkuSerializeTests : public testing::Test {
+protected:
+  void SetUp() override {
+    const auto test = testing::UnitTest::GetInstance()->current_test_info();
+    const auto path = testing::TempDir() + "ekuserialize_" + test->name();
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    ASSERT_LE(0, fd_);
+    // the file goes away along with the descriptor
+    ::unlink(path.c_str());
+  }
+
+  void TearDown() override { ::close(fd_); }
+
+  void rewind() { ASSERT_EQ(0, ::lseek(fd_, 0, SEEK_SET)); }
+
+  int fd_;
+};
+
+TEST_F(EkuSerializeTests, RoundTrip) {
+  ekuvector<Point> points;
+  for (int32_t i = 0; i < 10000; ++i) {
+    points.push_back(Point{i * 1.0f, i * 2.0f, i});
+  }
+  const ekuvector<int64_t> empty;
+  serialize(fd_, points);
+  serialize(fd_, empty);
+  const auto written = serialized_size(points) + serialized_size(empty);
+  EXPECT_EQ(static_cast<off_t>(written), ::lseek(fd_, 0, SEEK_CUR));
+  rewind();
+
+  ekuvector<Point> read_points({Point{0, 0, -1}});
+  ekuvector<int64_t> read_empty({1, 2, 3});
+  deserialize(fd_, read_points);
+  deserialize(fd_, read_empty);
+  ASSERT_EQ(10000, read_points.size());
+  EXPECT_EQ(9999, read_points.back().id);
+  EXPECT_EQ(10.0f, read_points[5].y);
+  EXPECT_TRUE(read_empty.empty());
+}
+
+TEST_F(EkuSerializeTests, MalformedData) {
+  serialize(fd_, ekuvector<int8_t>{1, 2, 3});
+  rewind();
+  ekuvector<int32_t> uut;
+  EXPECT_THROW(deserialize(fd_, uut), std::runtime_error);
+
+  rewind();
+  ASSERT_EQ(0, ::ftruncate(fd_, 10));
+  ekuvector<int8_t> bytes;
+  EXPECT_THROW(deserialize(fd_, bytes), std::runtime_error);
+
+  ekuvector<int8_t> nothing;
+  EXPECT_THROW(deserialize(-1, nothing), std::system_error);
+}
+
+TEST_F(EkuSerializeTests, HeaderIsNotTrusted) {
+  // claims a terabyte, but only three elements follow
+  const std::uint64_t header = std::uint64_t{1} << 40;
+  const int32_t elements[] = {1, 2, 3};
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(header)),
+            ::write(fd_, &header, sizeof(header)));
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(elements)),
+            ::write(fd_, elements, sizeof(elements)));
+  rewind();
+  ekuvector<int32_t> uut;
+  EXPECT_THROW(deserialize(fd_, uut), std::runtime_error);
+  EXPECT_GE(std::size_t{1} << 19, uut.capacity());
+}
+
+TEST_F(EkuSerializeTests, LargePayloadsArriveInChunks) {
+  ekuvector<int32_t> values(1000000);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int32_t>(i);
+  }
+  serialize(fd_, values);
+  rewind();
+  ekuvector<int32_t> uut;
+  deserialize(fd_, uut);
+  EXPECT_EQ(values, uut);
+  EXPECT_EQ(values.size(), uut.capacity());
+}
+
+}; // namespace ekustd
@@ -0,0 +1,398 @@
+/**
+ * ekusmallvector, ekuvector with inline storage for small sizes.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekusmallvector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* std::allocator that keeps track of the number of live heap blocks */
+template <class Type>
+class BlockCountingAllocator : public std::allocator<Type> {
+public:
+  template <class Other> struct rebind {
+    using other = BlockCountingAllocator<Other>;
+  };
+
+  BlockCountingAllocator() = default;
+  template <class Other>
+  BlockCountingAllocator(const BlockCountingAllocator<Other> &) {}
+
+  Type *allocate(std::size_t n) {
+    ++live_blocks_;
+    return std::allocator<Type>::allocate(n);
+  }
+
+  void deallocate(Type *p, std::size_t n) {
+    --live_blocks_;
+    std::allocator<Type>::deallocate(p, n);
+  }
+
+  static int32_t live_blocks_;
+};
+
+template <class Type> int32_t BlockCountingAllocator<Type>::live_blocks_ = 0;
+
+using StringSmallVector =
+    ekusmallvector<std::string, 4, BlockCountingAllocator<std::string>>;
+
+StringSmallVector make_strings(std::size_t count) {
+  StringSmallVector uut;
+  for (std::size_t index = 0; index < count; ++index) {
+    uut.push_back(std::to_string(index));
+  }
+  return uut;
+}
+
+void expect_strings(const StringSmallVector &uut, std::size_t count) {
+  ASSERT_EQ(count, uut.size());
+  for (std::size_t index = 0; index < count; ++index) {
+    ASSERT_EQ(std::to_string(index), uut[index]);
+  }
+}
+
+/* allocator that carries an id, and is swapped and move-assigned along with
+   the containers only if Propagate is true. All instances compare equal, so
+   blocks can always be exchanged */
+template <class Type, bool Propagate>
+class IdAllocator : public std::allocator<Type> {
+public:
+  using propagate_on_container_move_assignment =
+      std::integral_constant<bool, Propagate>;
+  using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+  using is_always_equal = std::true_type;
+
+  template <class Other> struct rebind {
+    using other = IdAllocator<Other, Propagate>;
+  };
+
+  explicit IdAllocator(int32_t id = 0) : id_{id} {}
+  template <class Other>
+  IdAllocator(const IdAllocator<Other, Propagate> &other) : id_{other.id_} {}
+
+  std::size_t max_size() const noexcept { return 1000; }
+
+  bool operator==(const IdAllocator &) const { return true; }
+  bool operator!=(const IdAllocator &) const { return false; }
+
+  int32_t id_;
+};
+
+/* string whose copy constructor throws once copies_left_ runs out */
+struct FragileString {
+  static int32_t copies_left_;
+
+  FragileString(const char *value) : value_{value} {}
+  FragileString(const FragileString &other) : value_{other.value_} {
+    if (copies_left_-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  FragileString(FragileString &&other) noexcept = default;
+  FragileString &operator=(const FragileString &) = default;
+  FragileString &operator=(FragileString &&) = default;
+
+  bool operator==(const FragileString &other) const {
+    return value_ == other.value_;
+  }
+
+  std::string value_;
+};
+
+int32_t FragileString::copies_left_ = INT32_MAX;
+
+/* string whose move constructor may throw, and throws once moves_left_ runs
+ * out */
+struct FragileMoveString {
+  static int32_t moves_left_;
+
+  FragileMoveString(const char *value) : value_{value} {}
+  FragileMoveString(const FragileMoveString &) = default;
+  FragileMoveString(FragileMoveString &&other) : value_{other.value_} {
+    if (moves_left_-- == 0) {
+      throw std::runtime_error("move failed");
+    }
+  }
+  FragileMoveString &operator=(const FragileMoveString &) = default;
+
+  bool operator==(const FragileMoveString &other) const {
+    return value_ == other.value_;
+  }
+
+  std::string value_;
+};
+
+int32_t FragileMoveString::moves_left_ = INT32_MAX;
+
+} // namespace
+
+class EkuSmallVectorTests : public testing::Test {
+protected:
+  void SetUp() override {
+    BlockCountingAllocator<std::string>::live_blocks_ = 0;
+  }
+
+  void TearDown() override {
+    ASSERT_EQ(0, BlockCountingAllocator<std::string>::live_blocks_);
+  }
+};
+
+TEST_F(EkuSmallVectorTests, StaysInlineUpToN) {
+  {
+    StringSmallVector uut;
+    ASSERT_TRUE(uut.is_inline());
+    ASSERT_EQ(4u, uut.capacity());
+    for (std::size_t index = 0; index < 4; ++index) {
+      uut.push_back(std::to_string(index));
+    }
+    ASSERT_TRUE(uut.is_inline());
+    ASSERT_EQ(0, BlockCountingAllocator<std::string>::live_blocks_);
+    expect_strings(uut, 4);
+  }
+}
+
+TEST_F(EkuSmallVectorTests, SpillsToTheHeapPastN) {
+  auto uut = make_strings(5);
+  ASSERT_FALSE(uut.is_inline());
+  ASSERT_LE(5u, uut.capacity());
+  ASSERT_EQ(1, BlockCountingAllocator<std::string>::live_blocks_);
+  expect_strings(uut, 5);
+
+  uut.insert(uut.begin(), uut[4]);
+  uut.erase(uut.begin());
+  expect_strings(uut, 5);
+}
+
+TEST_F(EkuSmallVectorTests, ShrinkToFitGoesBackInline) {
+  auto uut = make_strings(10);
+  uut.resize(3);
+  uut.shrink_to_fit();
+  ASSERT_TRUE(uut.is_inline());
+  ASSERT_EQ(4u, uut.capacity());
+  ASSERT_EQ(0, BlockCountingAllocator<std::string>::live_blocks_);
+  expect_strings(uut, 3);
+}
+
+TEST_F(EkuSmallVectorTests, MoveConstruction) {
+  auto inline_source = make_strings(3);
+  StringSmallVector inline_uut(std::move(inline_source));
+  ASSERT_TRUE(inline_uut.is_inline());
+  ASSERT_TRUE(inline_source.empty());
+  expect_strings(inline_uut, 3);
+
+  auto heap_source = make_strings(8);
+  const auto heap_data = heap_source.data();
+  StringSmallVector heap_uut(std::move(heap_source));
+  ASSERT_EQ(heap_data, heap_uut.data());
+  ASSERT_TRUE(heap_source.empty());
+  ASSERT_TRUE(heap_source.is_inline());
+  ASSERT_EQ(1, BlockCountingAllocator<std::string>::live_blocks_);
+  expect_strings(heap_uut, 8);
+}
+
+TEST_F(EkuSmallVectorTests, MoveAssignment) {
+  auto uut = make_strings(6);
+  auto heap_source = make_strings(8);
+  const auto heap_data = heap_source.data();
+  uut = std::move(heap_source);
+  ASSERT_EQ(heap_data, uut.data());
+  ASSERT_EQ(1, BlockCountingAllocator<std::string>::live_blocks_);
+  expect_strings(uut, 8);
+
+  auto inline_source = make_strings(2);
+  uut = std::move(inline_source);
+  ASSERT_TRUE(uut.is_inline());
+  ASSERT_EQ(0, BlockCountingAllocator<std::string>::live_blocks_);
+  expect_strings(uut, 2);
+}
+
+TEST_F(EkuSmallVectorTests, MoveAssignmentFollowsAllocatorPropagation) {
+  static_assert(std::is_nothrow_move_assignable<StringSmallVector>::value,
+                "blocks are handed over");
+  static_assert(
+      !std::is_nothrow_move_assignable<ekusmallvector<FragileMoveString, 2>>::
+          value,
+      "inline elements are moved one by one");
+
+  using Moving = ekusmallvector<int32_t, 2, IdAllocator<int32_t, true>>;
+  Moving moving({1, 2, 3}, IdAllocator<int32_t, true>(1));
+  moving = Moving({4}, IdAllocator<int32_t, true>(2));
+  EXPECT_EQ(2, moving.get_allocator().id_);
+  EXPECT_EQ((Moving{4}), moving);
+
+  using Staying = ekusmallvector<int32_t, 2, IdAllocator<int32_t, false>>;
+  Staying staying({1, 2, 3}, IdAllocator<int32_t, false>(1));
+  staying = Staying({4, 5, 6}, IdAllocator<int32_t, false>(2));
+  EXPECT_EQ(1, staying.get_allocator().id_);
+  EXPECT_EQ((Staying{4, 5, 6}), staying);
+}
+
+TEST_F(EkuSmallVectorTests, SwapBetweenStorageStates) {
+  auto short_uut = make_strings(1);
+  auto long_uut = make_strings(3);
+  short_uut.swap(long_uut);
+  expect_strings(short_uut, 3);
+  expect_strings(long_uut, 1);
+
+  auto heap_uut = make_strings(7);
+  const auto heap_data = heap_uut.data();
+  swap(short_uut, heap_uut);
+  ASSERT_EQ(heap_data, short_uut.data());
+  ASSERT_TRUE(heap_uut.is_inline());
+  expect_strings(short_uut, 7);
+  expect_strings(heap_uut, 3);
+
+  auto other_heap_uut = make_strings(9);
+  const auto other_heap_data = other_heap_uut.data();
+  short_uut.swap(other_heap_uut);
+  ASSERT_EQ(other_heap_data, short_uut.data());
+  ASSERT_EQ(heap_data, other_heap_uut.data());
+  ASSERT_EQ(2, BlockCountingAllocator<std::string>::live_blocks_);
+}
+
+TEST_F(EkuSmallVectorTests, CopyAndCompare) {
+  const auto source = make_strings(6);
+  StringSmallVector uut(source);
+  ASSERT_TRUE(uut == source);
+  uut.pop_back();
+  ASSERT_TRUE(uut < source);
+
+  uut = make_strings(2);
+  ASSERT_TRUE(uut != source);
+  uut = source;
+  ASSERT_TRUE(uut == source);
+}
+
+TEST_F(EkuSmallVectorTests, AssignRanges) {
+  std::istringstream input("1 2 3");
+  ekusmallvector<int32_t, 2> uut(std::istream_iterator<int32_t>(input),
+                                 std::istream_iterator<int32_t>{});
+  ASSERT_EQ((ekusmallvector<int32_t, 2>{1, 2, 3}), uut);
+  std::istringstream fewer("4 5");
+  uut.assign(std::istream_iterator<int32_t>(fewer),
+             std::istream_iterator<int32_t>());
+  ASSERT_EQ((ekusmallvector<int32_t, 2>{4, 5}), uut);
+
+  // ranges over the contents are assigned in place
+  auto strings = make_strings(8);
+  const auto data = strings.data();
+  strings.assign(strings.begin() + 2, strings.begin() + 6);
+  ASSERT_EQ(data, strings.data());
+  ASSERT_EQ((StringSmallVector{"2", "3", "4", "5"}), strings);
+}
+
+TEST_F(EkuSmallVectorTests, InsertSinglePassRange) {
+  std::istringstream input("1 2 3");
+  ekusmallvector<int32_t, 8> uut{9};
+  uut.insert(uut.cbegin(), std::istream_iterator<int32_t>(input),
+             std::istream_iterator<int32_t>());
+  ASSERT_EQ((ekusmallvector<int32_t, 8>{1, 2, 3, 9}), uut);
+
+  std::istringstream more("4 5 6 7 8");
+  uut.insert(uut.cbegin() + 1, std::istream_iterator<int32_t>(more),
+             std::istream_iterator<int32_t>());
+  ASSERT_EQ((ekusmallvector<int32_t, 8>{1, 4, 5, 6, 7, 8, 2, 3, 9}), uut);
+  ASSERT_FALSE(uut.is_inline());
+}
+
+TEST_F(EkuSmallVectorTests, InsertRangeOfItsOwnElements) {
+  StringSmallVector uut{"a", "b"};
+  uut.insert(uut.cbegin(), uut.begin(), uut.end());
+  ASSERT_TRUE(uut.is_inline());
+  ASSERT_EQ((StringSmallVector{"a", "b", "a", "b"}), uut);
+
+  uut = {"a", "b", "c"};
+  uut.reserve(16);
+  uut.insert(uut.cbegin(), uut.begin(), uut.end());
+  ASSERT_EQ((StringSmallVector{"a", "b", "c", "a", "b", "c"}), uut);
+  uut.insert(uut.cbegin() + 1, uut.rbegin(), uut.rbegin() + 2);
+  ASSERT_EQ((StringSmallVector{"a", "c", "b", "b", "c", "a", "b", "c"}), uut);
+
+  // growing copies the range before the old block goes away
+  uut.shrink_to_fit();
+  uut.insert(uut.cend(), uut.begin(), uut.begin() + 3);
+  ASSERT_EQ((StringSmallVector{"a", "c", "b", "b", "c", "a", "b", "c", "a",
+                               "c", "b"}),
+            uut);
+}
+
+TEST_F(EkuSmallVectorTests, FailedInsertLeavesContentsIntact) {
+  using FragileVector = ekusmallvector<FragileString, 8>;
+  const FragileString more[] = {"x", "y", "z"};
+  FragileVector uut{"a", "b", "c"};
+
+  FragileString::copies_left_ = 1;
+  ASSERT_THROW(uut.insert(uut.cbegin() + 1, std::begin(more), std::end(more)),
+               std::runtime_error);
+  ASSERT_EQ((FragileVector{"a", "b", "c"}), uut);
+
+  FragileString::copies_left_ = 1;
+  ASSERT_THROW(uut.insert(uut.cbegin(), 3, more[0]), std::runtime_error);
+  ASSERT_EQ((FragileVector{"a", "b", "c"}), uut);
+
+  // past the inline capacity, the old contents stay where they were
+  const FragileVector many(6, more[0]);
+  FragileString::copies_left_ = 3;
+  const auto data = uut.data();
+  ASSERT_THROW(uut.insert(uut.cbegin(), many.begin(), many.end()),
+               std::runtime_error);
+  ASSERT_EQ(data, uut.data());
+  ASSERT_EQ((FragileVector{"a", "b", "c"}), uut);
+  FragileString::copies_left_ = INT32_MAX;
+}
+
+TEST_F(EkuSmallVectorTests, InsertDoesNotShiftFragileMoves) {
+  using FragileVector = ekusmallvector<FragileMoveString, 8>;
+  const FragileMoveString more[] = {"x", "y"};
+  FragileVector uut{"a", "b", "c"};
+
+  FragileMoveString::moves_left_ = 1;
+  uut.insert(uut.cbegin(), 2, more[0]);
+  uut.insert(uut.cbegin() + 1, std::begin(more), std::end(more));
+  ASSERT_EQ((FragileVector{"x", "x", "y", "x", "a", "b", "c"}), uut);
+  FragileMoveString::moves_left_ = INT32_MAX;
+}
+
+TEST_F(EkuSmallVectorTests, SwapFollowsAllocatorPropagation) {
+  using Swapping = ekusmallvector<int32_t, 2, IdAllocator<int32_t, true>>;
+  Swapping lhs({1, 2, 3}, IdAllocator<int32_t, true>(1));
+  Swapping rhs({4}, IdAllocator<int32_t, true>(2));
+  lhs.swap(rhs);
+  EXPECT_EQ(2, lhs.get_allocator().id_);
+  EXPECT_EQ(1, rhs.get_allocator().id_);
+  EXPECT_EQ((Swapping{1, 2, 3}), rhs);
+
+  using Staying = ekusmallvector<int32_t, 2, IdAllocator<int32_t, false>>;
+  Staying first({1, 2, 3}, IdAllocator<int32_t, false>(1));
+  Staying second({4}, IdAllocator<int32_t, false>(2));
+  swap(first, second);
+  EXPECT_EQ(1, first.get_allocator().id_);
+  EXPECT_EQ(2, second.get_allocator().id_);
+  EXPECT_EQ((Staying{1, 2, 3}), second);
+}
+
+TEST_F(EkuSmallVectorTests, MaxSizeComesFromTheAllocator) {
+  EXPECT_EQ(1000, (ekusmallvector<int32_t, 2, IdAllocator<int32_t, true>>{})
+                      .max_size());
+  EXPECT_EQ((std::allocator_traits<std::allocator<int64_t>>::max_size(
+                std::allocator<int64_t>{})),
+            (ekusmallvector<int64_t, 2>{}.max_size()));
+}
+
+}; // namespace ekustd
@@ -0,0 +1,146 @@
+/**
+ * ekusoa_vector, structure-of-arrays container of records.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekusoa_vector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+using Particles = ekusoa_vector<float, double, int8_t, std::string>;
+
+Particles make_particles(int32_t count) {
+  Particles uut;
+  for (int32_t i = 0; i < count; ++i) {
+    uut.emplace_back(i * 1.0f, i * 2.0, static_cast<int8_t>(i % 100),
+                     std::to_string(i));
+  }
+  return uut;
+}
+
+} // namespace
+
+class EkuSoaVectorTests : public testing::Test {};
+
+TEST_F(EkuSoaVectorTests, ColumnsAreContiguousAndAligned) {
+  auto uut = make_particles(1000);
+  ASSERT_EQ(1000, uut.size());
+  EXPECT_LE(1000, uut.capacity());
+  EXPECT_EQ(4, Particles::field_count);
+
+  const auto xs = uut.data<0>();
+  const auto ys = uut.data<1>();
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(ys) % alignof(double));
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(uut.data<3>()) %
+                    alignof(std::string));
+  EXPECT_EQ(999.0f * 1000.0f / 2.0f, std::accumulate(xs, xs + 1000, 0.0f));
+  for (int32_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(i * 2.0, ys[i]);
+    ASSERT_EQ(std::to_string(i), uut.data<3>()[i]);
+  }
+  // all of the columns share one block, one after the other
+  EXPECT_LT(static_cast<const void *>(xs), static_cast<const void *>(ys));
+  EXPECT_LE(static_cast<const void *>(xs + uut.capacity()),
+            static_cast<const void *>(ys));
+}
+
+TEST_F(EkuSoaVectorTests, RowProxies) {
+  auto uut = make_particles(10);
+  std::get<1>(uut[3]) = -1.0;
+  std::get<3>(uut.back()) = "last";
+  uut[0] = std::make_tuple(10.0f, 20.0, int8_t{30}, std::string("first"));
+  EXPECT_EQ(-1.0, uut.data<1>()[3]);
+  EXPECT_EQ("last", uut.data<3>()[9]);
+  EXPECT_EQ(30, std::get<2>(uut.front()));
+  EXPECT_EQ("first", std::get<3>(uut.at(0)));
+  EXPECT_THROW(uut.at(10), std::out_of_range);
+
+  const Particles::value_type record = uut[3];
+  EXPECT_EQ(3.0f, std::get<0>(record));
+
+  const auto &const_uut = uut;
+  float x = 0;
+  std::string name;
+  std::tie(x, std::ignore, std::ignore, name) = const_uut[5];
+  EXPECT_EQ(5.0f, x);
+  EXPECT_EQ("5", name);
+}
+
+TEST_F(EkuSoaVectorTests, RowIterators) {
+  auto uut = make_particles(100);
+  int32_t visited = 0;
+  for (auto row : uut) {
+    ASSERT_EQ(std::to_string(visited), std::get<3>(row));
+    std::get<0>(row) *= -1.0f;
+    ++visited;
+  }
+  EXPECT_EQ(100, visited);
+  EXPECT_EQ(100, uut.end() - uut.begin());
+  EXPECT_EQ(-42.0f, uut.data<0>()[42]);
+
+  const auto found = std::find_if(
+      uut.cbegin(), uut.cend(),
+      [](Particles::const_reference row) { return std::get<3>(row) == "57"; });
+  ASSERT_NE(uut.cend(), found);
+  EXPECT_EQ(57, found.index());
+  EXPECT_EQ(58.0 * 2.0, std::get<1>(found[1]));
+  Particles::const_iterator converted = uut.begin() + 57;
+  EXPECT_TRUE(converted == found);
+}
+
+TEST_F(EkuSoaVectorTests, RecordsAndCapacity) {
+  Particles uut;
+  const Particles::value_type record(1.0f, 2.0, int8_t{3}, "four");
+  uut.push_back(record);
+  uut.push_back(Particles::value_type(5.0f, 6.0, int8_t{7}, "eight"));
+  // arguments from the container itself survive the reallocation
+  for (int32_t i = 0; i < 20; ++i) {
+    uut.emplace_back(std::get<0>(uut[0]), std::get<1>(uut[0]),
+                     std::get<2>(uut[0]), std::get<3>(uut[0]));
+  }
+  ASSERT_EQ(22, uut.size());
+  EXPECT_EQ("four", uut.data<3>()[21]);
+  EXPECT_EQ("eight", uut.data<3>()[1]);
+
+  uut.pop_back();
+  uut.resize(30);
+  EXPECT_EQ(0.0f, std::get<0>(uut[29]));
+  EXPECT_EQ("", std::get<3>(uut[29]));
+  uut.resize(2);
+  uut.shrink_to_fit();
+  EXPECT_EQ(2, uut.capacity());
+  uut.reserve(100);
+  EXPECT_EQ(100, uut.capacity());
+  EXPECT_EQ("eight", std::get<3>(uut.back()));
+
+  Particles copy(uut);
+  Particles moved(std::move(uut));
+  EXPECT_TRUE(uut.empty());
+  ASSERT_EQ(2, copy.size());
+  EXPECT_EQ("four", std::get<3>(copy[0]));
+  EXPECT_EQ(6.0, std::get<1>(moved[1]));
+  copy = moved;
+  swap(copy, uut);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(2, uut.size());
+  uut.clear();
+  EXPECT_TRUE(uut.empty());
+  EXPECT_EQ(2, uut.capacity());
+}
+
+}; // namespace ekustd
@@ -0,0 +1,144 @@
+/**
+ * ekustatic_vector, vector with a fixed capacity and no allocator.
+ * @author Gerardo Puga
+ * */
+
+// Standard library
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// gtest and gmock
+#include "gtest/gtest.h"
+
+// Library
+#include <ekuvector/ekustatic_vector.hpp>
+
+namespace ekustd {
+
+namespace {
+
+/* squares of the first N integers, computed by the compiler */
+template <std::size_t N> constexpr ekustatic_vector<int32_t, N> squares() {
+  ekustatic_vector<int32_t, N> table;
+  for (std::size_t i = 0; i < N; ++i) {
+    table.push_back(static_cast<int32_t>(i * i));
+  }
+  table.erase(table.begin());
+  table.insert(table.begin(), 0);
+  return table;
+}
+
+constexpr auto square_table = squares<16>();
+
+static_assert(square_table.size() == 16, "built at compile time");
+static_assert(square_table[15] == 225, "built at compile time");
+static_assert(square_table.back() == 225, "built at compile time");
+static_assert(square_table == squares<16>(), "comparable at compile time");
+
+static_assert(sizeof(ekustatic_vector<char, 10>) == 11, "one byte of size");
+static_assert(sizeof(ekustatic_vector<char, 300>) == 302, "two bytes of size");
+static_assert(std::is_same<detail::smallest_size_type<255>, uint8_t>::value,
+              "");
+static_assert(std::is_same<detail::smallest_size_type<256>, uint16_t>::value,
+              "");
+static_assert(
+    std::is_same<detail::smallest_size_type<70000>, uint32_t>::value, "");
+static_assert(sizeof(ekustatic_vector<std::string, 4>) ==
+                  4 * sizeof(std::string) + alignof(std::string),
+              "no pointers besides the elements");
+
+} // namespace
+
+class EkuStaticVectorTests : public testing::Test {};
+
+TEST_F(EkuStaticVectorTests, ConstexprTables) {
+  EXPECT_EQ(16, square_table.size());
+  EXPECT_EQ(0, square_table.front());
+  EXPECT_EQ(49, square_table.at(7));
+  EXPECT_EQ(1240, std::accumulate(square_table.begin(), square_table.end(), 0));
+  EXPECT_EQ(225, *square_table.rbegin());
+  EXPECT_THROW(square_table.at(16), std::out_of_range);
+}
+
+TEST_F(EkuStaticVectorTests, FixedCapacity) {
+  ekustatic_vector<std::string, 4> uut{"a", "b"};
+  EXPECT_EQ(4, uut.capacity());
+  EXPECT_EQ(4, uut.max_size());
+  uut.reserve(4);
+  EXPECT_THROW(uut.reserve(5), std::length_error);
+  uut.emplace_back(3, 'c');
+  uut.push_back("d");
+  EXPECT_THROW(uut.push_back("e"), std::length_error);
+  EXPECT_THROW(uut.insert(uut.cbegin(), "e"), std::length_error);
+  EXPECT_THROW(uut.resize(5), std::length_error);
+  EXPECT_EQ((ekustatic_vector<std::string, 4>{"a", "b", "ccc", "d"}), uut);
+
+  // ranges that don't fit leave trivial elements untouched too
+  ekustatic_vector<int32_t, 4> numbers{1, 2};
+  EXPECT_THROW(numbers.insert(numbers.cbegin(), {7, 8, 9}), std::length_error);
+  const std::vector<int32_t> more = {7, 8, 9};
+  EXPECT_THROW(numbers.insert(numbers.cbegin(), more.begin(), more.end()),
+               std::length_error);
+  EXPECT_EQ((ekustatic_vector<int32_t, 4>{1, 2}), numbers);
+
+  // the object holds the elements
+  const auto address = reinterpret_cast<const char *>(uut.data());
+  EXPECT_LE(reinterpret_cast<const char *>(&uut), address);
+  EXPECT_GT(reinterpret_cast<const char *>(&uut) + sizeof(uut), address);
+}
+
+TEST_F(EkuStaticVectorTests, InsertAndErase) {
+  ekustatic_vector<std::string, 16> uut{"a", "b", "c"};
+  auto it = uut.insert(uut.cbegin() + 1, "x");
+  EXPECT_EQ("x", *it);
+  uut.insert(uut.cend(), 2, "y");
+  const std::string more[] = {"p", "q"};
+  uut.insert(uut.cbegin(), std::begin(more), std::end(more));
+  uut.emplace(uut.cbegin() + 2, 2, 'z');
+  uut.insert(uut.cbegin(), uut.back());
+  EXPECT_EQ((ekustatic_vector<std::string, 16>{"y", "p", "q", "zz", "a", "x",
+                                               "b", "c", "y", "y"}),
+            uut);
+  it = uut.erase(uut.cbegin() + 3);
+  EXPECT_EQ("a", *it);
+  it = uut.erase(uut.cbegin() + 5, uut.cend());
+  EXPECT_EQ(uut.end(), it);
+  uut.pop_back();
+  EXPECT_EQ((ekustatic_vector<std::string, 16>{"y", "p", "q", "a"}), uut);
+}
+
+TEST_F(EkuStaticVectorTests, CopyMoveAndSwap) {
+  ekustatic_vector<std::unique_ptr<int32_t>, 8> pointers;
+  pointers.emplace_back(new int32_t(1));
+  pointers.emplace_back(new int32_t(2));
+  auto moved = std::move(pointers);
+  ASSERT_EQ(2, moved.size());
+  EXPECT_EQ(2, *moved[1]);
+
+  ekustatic_vector<std::string, 8> lhs(3, "l");
+  ekustatic_vector<std::string, 8> rhs(5);
+  rhs.assign({"r", "r", "r", "r", "r"});
+  const auto copy = lhs;
+  lhs.swap(rhs);
+  EXPECT_EQ(5, lhs.size());
+  EXPECT_EQ(copy, rhs);
+  swap(lhs, rhs);
+  EXPECT_EQ(copy, lhs);
+  EXPECT_LT(lhs, rhs);
+  EXPECT_NE(lhs, rhs);
+  rhs = lhs;
+  EXPECT_EQ(lhs, rhs);
+  rhs.resize(6, "s");
+  EXPECT_EQ("s", rhs.back());
+  rhs.resize(1);
+  EXPECT_EQ((ekustatic_vector<std::string, 8>{"l"}), rhs);
+  rhs.clear();
+  EXPECT_TRUE(rhs.empty());
+}
+
+}; // namespace ekustd